@@ -0,0 +1,1517 @@
+/**
+ * @file amp_bench.c
+ * @brief IPC Benchmark - latency and throughput between two cores
+ *
+ * Drives amp_mailbox, amp_ringbuf and amp_semaphore between core 0 and a
+ * simulated core 1 (host-threads or host-process platform) and prints the
+ * results as JSON:
+ * - ops/s and MB/s for streaming transfers
+ * - p50/p99/p99.9/max round-trip latency in nanoseconds
+ * - single-core ring buffer copy bandwidth
+ * - idle cost of amp_poll against scanning every channel
+ * - typed AMP_DEFINE_CHANNEL channels, with and without doorbells, against
+ *   mailboxes of the same size
+ * - amp_rpc call rate, one call at a time against a window in flight
+ * - wakeup latency against waiter CPU time for each wait policy
+ * - snapshot reads of state updated by the other core, seqlock against semaphore
+ * - age of the samples a slow consumer reads, amp_latest against a mailbox
+ *
+ * Usage: amp-bench [-n rtt_iterations] [-t stream_messages] [-s suite]
+ *
+ * Suites: mailbox, channel, ringbuf, semaphore, poll, rpc, wait, snapshot, latest,
+ * bandwidth (default: all)
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "amp_atomic.h"
+#include "amp_boot.h"
+#include "amp_channel.h"
+#include "amp_config.h"
+#include "amp_event_group.h"
+#include "amp_mailbox.h"
+#include "amp_poll.h"
+#include "amp_ringbuf.h"
+#include "amp_rpc.h"
+#include "amp_latest.h"
+#include "amp_semaphore.h"
+#include "amp_seqlock.h"
+#include "amp_shmem.h"
+#include "amp_time.h"
+#include "amp_wait.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+/* Shared memory configuration */
+#ifndef SHMEM_BASE
+#define SHMEM_BASE 0x20040000
+#endif
+#ifndef SHMEM_SIZE
+#define SHMEM_SIZE (1024 * 1024)
+#endif
+
+#ifndef AMP_BENCH_PLATFORM
+#define AMP_BENCH_PLATFORM "unknown"
+#endif
+
+/* Control block layout the runtime was built with */
+#if defined(AMP_LAYOUT_PADDED)
+#define BENCH_LAYOUT "padded"
+#else
+#define BENCH_LAYOUT "compact"
+#endif
+
+/* Timeout for any single blocking step; a stuck core aborts the run */
+#define BENCH_TIMEOUT_MS 10000
+
+/* Largest message / chunk moved by any benchmark */
+#define BENCH_MAX_XFER 4096
+
+/* Benchmark commands executed by core 1 */
+typedef enum {
+    BENCH_OP_MAILBOX_ECHO,    /* recv from a, send back to b, count times */
+    BENCH_OP_MAILBOX_SINK,    /* recv count messages from a */
+    BENCH_OP_MAILBOX_BATCH_SINK, /* recv_batch count messages of size bytes from a */
+    BENCH_OP_MAILBOX_VAR_SINK, /* recv_var count messages of up to size bytes from a */
+    BENCH_OP_CHANNEL_SINK,    /* recv count messages from typed channel a of size bytes */
+    BENCH_OP_RINGBUF_ECHO,    /* read size bytes from a, write to b, count times */
+    BENCH_OP_RINGBUF_SINK,    /* read count * size bytes from a */
+    BENCH_OP_SEMAPHORE_ECHO,  /* wait on a, post b, count times */
+    BENCH_OP_POLL_ECHO,       /* poll channels of a, echo each message to b, count times */
+    BENCH_OP_RPC_SERVE,       /* serve count echo calls of rpc a */
+    BENCH_OP_WAIT_ECHO,       /* wait/post the semaphores of a count times, timing the CPU */
+    BENCH_OP_WAIT_ON_ECHO,    /* same on the words of a with amp_wait_on, policy size */
+    BENCH_OP_SNAPSHOT_WRITE,  /* update snapshot a until stopped, seqlock if size != 0 */
+    BENCH_OP_SAMPLE_PUBLISH,  /* publish samples to a until stopped, amp_latest if size != 0 */
+    BENCH_OP_EVENT_SIGNAL     /* wait for go of a, signal its conditions, count times;
+                                 event group if size != 0 */
+} bench_op_t;
+
+/* Command message; handles point into shared memory */
+typedef struct {
+    uint32_t op;
+    uint32_t size;
+    uint32_t count;
+    void *a;
+    void *b;
+} bench_cmd_t;
+
+/* Channels polled by core 1, kept in shared memory */
+typedef struct {
+    amp_poll_set_t set;
+    amp_mailbox_t chans[AMP_POLL_MAX_ITEMS];
+} bench_poll_t;
+
+/* Semaphore and word pairs of the wait policy benchmark, kept in shared memory */
+typedef struct {
+    amp_semaphore_t request;
+    amp_semaphore_t response;
+    amp_atomic_u32_t request_seq;
+    amp_atomic_u32_t response_seq;
+    volatile uint64_t cpu_ns;   /* CPU time core 1 spent in the run */
+} bench_wait_t;
+
+/* Snapshot state updated by core 1, kept in shared memory */
+#define BENCH_SNAPSHOT_WORDS 50
+
+typedef struct {
+    amp_seqlock_t lock;
+    amp_semaphore_t sem;
+    volatile uint32_t stop;
+    volatile uint32_t updates;  /* Updates core 1 made in the run */
+    uint32_t words[BENCH_SNAPSHOT_WORDS];
+} bench_snapshot_t;
+
+/* Sample stream from core 1 to a slow consumer, kept in shared memory */
+#define BENCH_SAMPLE_WORDS 16
+#define BENCH_SAMPLE_SLOTS 16
+#define BENCH_SAMPLE_WORK_US 2
+
+typedef struct {
+    amp_latest_t latest;
+    amp_mailbox_t mbox;
+    volatile uint32_t stop;
+    volatile uint32_t seq;      /* Newest sample published */
+    volatile uint32_t drops;    /* Samples the mailbox had no room for */
+} bench_sample_t;
+
+/* Conditions core 1 signals to core 0, kept in shared memory */
+#define BENCH_EVENT_CONDITIONS 8
+
+typedef struct {
+    amp_semaphore_t go;
+    amp_event_group_t group;
+    amp_semaphore_t sems[BENCH_EVENT_CONDITIONS];
+} bench_events_t;
+
+/* Typed channels, one per benchmarked message size */
+typedef struct { uint32_t w[2]; } bench_msg8_t;
+typedef struct { uint32_t w[4]; } bench_msg16_t;
+
+#define BENCH_CHANNEL_SLOTS 16
+
+AMP_DEFINE_CHANNEL(bench_chan8, bench_msg8_t, BENCH_CHANNEL_SLOTS)
+AMP_DEFINE_CHANNEL(bench_chan16, bench_msg16_t, BENCH_CHANNEL_SLOTS)
+
+/* Control mailboxes */
+static amp_mailbox_t g_ctl_to_core1 = NULL;
+static amp_mailbox_t g_ctl_to_core0 = NULL;
+
+/* Round-trip samples in counter cycles */
+static uint32_t *g_samples = NULL;
+
+/* Output state */
+static int g_first_result = 1;
+
+/* Suite selected with -s (NULL = all) */
+static const char *g_suite = NULL;
+
+/**
+ * Check whether a suite should run
+ */
+static int suite_enabled(const char *suite)
+{
+    return !g_suite || strcmp(g_suite, suite) == 0;
+}
+
+/**
+ * Abort the run with a message
+ */
+static void bench_fail(const char *what)
+{
+    fprintf(stderr, "amp-bench: %s failed\n", what);
+    exit(1);
+}
+
+/**
+ * Transfer a whole buffer through a ring buffer, waiting whenever it is full
+ */
+static void ringbuf_write_all(amp_ringbuf_t rb, const char *data, size_t len)
+{
+    while (len > 0) {
+        size_t n = amp_ringbuf_write(rb, data, len);
+        if (n == 0) {
+            amp_ringbuf_wait_space(rb, 1, 0);
+        }
+        data += n;
+        len -= n;
+    }
+}
+
+/**
+ * Fill a whole buffer from a ring buffer, waiting whenever it is empty
+ */
+static void ringbuf_read_all(amp_ringbuf_t rb, char *data, size_t len)
+{
+    while (len > 0) {
+        size_t n = amp_ringbuf_read(rb, data, len);
+        if (n == 0) {
+            amp_ringbuf_wait_available(rb, 1, 0);
+        }
+        data += n;
+        len -= n;
+    }
+}
+
+/**
+ * CPU time consumed by the calling thread, in nanoseconds
+ */
+static uint64_t thread_cpu_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * RPC method: echo the request
+ */
+static int bench_rpc_echo(void *ctx, const void *req, uint32_t req_len, void *resp,
+                          uint32_t *resp_len)
+{
+    (void)ctx;
+    memcpy(resp, req, req_len);
+    *resp_len = req_len;
+
+    return AMP_RPC_OK;
+}
+
+/**
+ * RPC completion: count the call
+ */
+static void bench_rpc_done(void *arg, int status, const void *resp, uint32_t resp_len)
+{
+    (void)resp;
+    (void)resp_len;
+
+    if (status == AMP_RPC_OK) {
+        (*(uint32_t *)arg)++;
+    }
+}
+
+/**
+ * Core 1 entry point - executes benchmark commands forever
+ */
+void core1_main(void)
+{
+    static char buf[BENCH_MAX_XFER];
+
+    amp_boot_signal_ready();
+
+    while (1) {
+        bench_cmd_t cmd;
+        if (amp_mailbox_recv(g_ctl_to_core1, &cmd, 0) != 0) {
+            continue;
+        }
+
+        switch (cmd.op) {
+        case BENCH_OP_MAILBOX_ECHO:
+            for (uint32_t i = 0; i < cmd.count; i++) {
+                amp_mailbox_recv(cmd.a, buf, 0);
+                amp_mailbox_send(cmd.b, buf, 0);
+            }
+            break;
+
+        case BENCH_OP_MAILBOX_SINK:
+            for (uint32_t i = 0; i < cmd.count; i++) {
+                amp_mailbox_recv(cmd.a, buf, 0);
+            }
+            break;
+
+        case BENCH_OP_MAILBOX_BATCH_SINK:
+            for (uint32_t i = 0; i < cmd.count; ) {
+                i += (uint32_t)amp_mailbox_recv_batch(cmd.a, buf, BENCH_MAX_XFER / cmd.size, 0);
+            }
+            break;
+
+        case BENCH_OP_MAILBOX_VAR_SINK:
+            for (uint32_t i = 0; i < cmd.count; i++) {
+                uint32_t len;
+                amp_mailbox_recv_var(cmd.a, buf, sizeof(buf), &len, 0);
+            }
+            break;
+
+        case BENCH_OP_CHANNEL_SINK:
+            for (uint32_t i = 0; i < cmd.count; i++) {
+                if (cmd.size == sizeof(bench_msg8_t)) {
+                    bench_chan8_recv(cmd.a, (bench_msg8_t *)buf, 0);
+                } else {
+                    bench_chan16_recv(cmd.a, (bench_msg16_t *)buf, 0);
+                }
+            }
+            break;
+
+        case BENCH_OP_RINGBUF_ECHO:
+            for (uint32_t i = 0; i < cmd.count; i++) {
+                ringbuf_read_all(cmd.a, buf, cmd.size);
+                ringbuf_write_all(cmd.b, buf, cmd.size);
+            }
+            break;
+
+        case BENCH_OP_RINGBUF_SINK:
+            for (uint32_t i = 0; i < cmd.count; i++) {
+                ringbuf_read_all(cmd.a, buf, cmd.size);
+            }
+            break;
+
+        case BENCH_OP_SEMAPHORE_ECHO:
+            for (uint32_t i = 0; i < cmd.count; i++) {
+                amp_semaphore_wait(cmd.a, 0);
+                amp_semaphore_post(cmd.b);
+            }
+            break;
+
+        case BENCH_OP_POLL_ECHO: {
+            bench_poll_t *poll = cmd.a;
+            for (uint32_t i = 0; i < cmd.count; ) {
+                uint32_t ready = amp_poll(poll->set, 0);
+                while (ready != 0) {
+                    uint32_t chan = (uint32_t)__builtin_ctz(ready);
+                    ready &= ready - 1u;
+                    if (amp_mailbox_try_recv(poll->chans[chan], buf) == 0) {
+                        amp_mailbox_send(cmd.b, buf, 0);
+                        i++;
+                    }
+                }
+            }
+            break;
+        }
+
+        case BENCH_OP_WAIT_ECHO: {
+            bench_wait_t *wait = cmd.a;
+            uint64_t cpu_start = thread_cpu_ns();
+            for (uint32_t i = 0; i < cmd.count; i++) {
+                amp_semaphore_wait(wait->request, 0);
+                amp_semaphore_post(wait->response);
+            }
+            wait->cpu_ns = thread_cpu_ns() - cpu_start;
+            break;
+        }
+
+        case BENCH_OP_WAIT_ON_ECHO: {
+            bench_wait_t *wait = cmd.a;
+            amp_wait_policy_t saved = amp_wait_get_default_policy();
+            amp_wait_set_default_policy((amp_wait_policy_t)cmd.size);
+            uint64_t cpu_start = thread_cpu_ns();
+            for (uint32_t i = 0; i < cmd.count; i++) {
+                amp_wait_on(&wait->request_seq, i, 0);
+                amp_atomic_store_release(&wait->response_seq, i + 1);
+                amp_wake(&wait->response_seq);
+            }
+            wait->cpu_ns = thread_cpu_ns() - cpu_start;
+            amp_wait_set_default_policy(saved);
+            break;
+        }
+
+        case BENCH_OP_EVENT_SIGNAL: {
+            bench_events_t *events = cmd.a;
+            for (uint32_t i = 0; i < cmd.count; i++) {
+                amp_semaphore_wait(events->go, 0);
+                if (cmd.size) {
+                    amp_event_group_set_bits(events->group, (1u << BENCH_EVENT_CONDITIONS) - 1);
+                } else {
+                    for (uint32_t c = 0; c < BENCH_EVENT_CONDITIONS; c++) {
+                        amp_semaphore_post(events->sems[c]);
+                    }
+                }
+            }
+            break;
+        }
+
+        case BENCH_OP_SNAPSHOT_WRITE: {
+            bench_snapshot_t *snap = cmd.a;
+            uint32_t words[BENCH_SNAPSHOT_WORDS];
+            uint32_t n = 0;
+            while (!snap->stop) {
+                n++;
+                for (uint32_t w = 0; w < BENCH_SNAPSHOT_WORDS; w++) {
+                    words[w] = n;
+                }
+                if (cmd.size) {
+                    amp_seqlock_write(&snap->lock, snap->words, words, sizeof(words));
+                } else {
+                    amp_semaphore_wait(snap->sem, 0);
+                    memcpy(snap->words, words, sizeof(words));
+                    amp_semaphore_post(snap->sem);
+                }
+            }
+            snap->updates = n;
+            break;
+        }
+
+        case BENCH_OP_SAMPLE_PUBLISH: {
+            bench_sample_t *stream = cmd.a;
+            uint32_t sample[BENCH_SAMPLE_WORDS] = { 0 };
+            uint32_t drops = 0;
+            while (!stream->stop) {
+                sample[0]++;
+                stream->seq = sample[0];
+                if (cmd.size) {
+                    amp_latest_publish(stream->latest, sample, sizeof(sample));
+                } else if (amp_mailbox_try_send(stream->mbox, sample) != 0) {
+                    drops++;
+                }
+            }
+            stream->drops = drops;
+            break;
+        }
+
+        case BENCH_OP_RPC_SERVE:
+            amp_rpc_register(cmd.a, 0, bench_rpc_echo, NULL);
+            for (uint32_t i = 0; i < cmd.count; ) {
+                i += amp_rpc_serve(cmd.a, 0);
+            }
+            break;
+
+        default:
+            break;
+        }
+
+        /* Acknowledge completion */
+        amp_mailbox_send(g_ctl_to_core0, &cmd, 0);
+    }
+}
+
+/**
+ * Start a command on core 1
+ */
+static void bench_start(bench_op_t op, uint32_t size, uint32_t count, void *a, void *b)
+{
+    bench_cmd_t cmd = {
+        .op = op,
+        .size = size,
+        .count = count,
+        .a = a,
+        .b = b
+    };
+
+    if (amp_mailbox_send(g_ctl_to_core1, &cmd, BENCH_TIMEOUT_MS) != 0) {
+        bench_fail("command send");
+    }
+}
+
+/**
+ * Wait for core 1 to finish the current command
+ */
+static void bench_finish(void)
+{
+    bench_cmd_t ack;
+
+    if (amp_mailbox_recv(g_ctl_to_core0, &ack, BENCH_TIMEOUT_MS) != 0) {
+        bench_fail("command completion");
+    }
+}
+
+/**
+ * Sort helper for latency samples
+ */
+static int sample_cmp(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * Convert counter cycles to nanoseconds
+ */
+static double cycles_to_ns(uint32_t cycles)
+{
+    return (double)cycles * 1e9 / (double)amp_time_cycle_hz();
+}
+
+/**
+ * Start one JSON result object
+ */
+static void report_begin(const char *bench)
+{
+    printf("%s\n    {\"bench\": \"%s\"", g_first_result ? "" : ",", bench);
+    g_first_result = 0;
+}
+
+/**
+ * Add an integer parameter to the current result
+ */
+static void report_param(const char *name, uint32_t value)
+{
+    printf(", \"%s\": %u", name, value);
+}
+
+/**
+ * Add a measured value to the current result
+ */
+static void report_real(const char *name, double value)
+{
+    printf(", \"%s\": %.1f", name, value);
+}
+
+/**
+ * Add a string parameter to the current result
+ */
+static void report_string(const char *name, const char *value)
+{
+    printf(", \"%s\": \"%s\"", name, value);
+}
+
+/**
+ * Add throughput figures to the current result
+ */
+static void report_throughput(uint32_t ops, uint64_t bytes, amp_time_t elapsed_us)
+{
+    double secs = (double)(elapsed_us ? elapsed_us : 1) / 1e6;
+
+    printf(", \"ops_per_s\": %.0f, \"mb_per_s\": %.2f",
+           (double)ops / secs, (double)bytes / secs / 1e6);
+}
+
+/**
+ * Add round-trip latency percentiles to the current result
+ */
+static void report_latency(uint32_t n)
+{
+    qsort(g_samples, n, sizeof(g_samples[0]), sample_cmp);
+
+    printf(", \"latency_ns\": {\"p50\": %.0f, \"p99\": %.0f, \"p99.9\": %.0f, \"max\": %.0f}",
+           cycles_to_ns(g_samples[(n - 1) / 2]),
+           cycles_to_ns(g_samples[(uint32_t)((uint64_t)(n - 1) * 990 / 1000)]),
+           cycles_to_ns(g_samples[(uint32_t)((uint64_t)(n - 1) * 999 / 1000)]),
+           cycles_to_ns(g_samples[n - 1]));
+}
+
+/**
+ * End the current JSON result object
+ */
+static void report_end(void)
+{
+    printf("}");
+}
+
+/**
+ * Name of a mailbox mode for the report
+ */
+static const char *mailbox_mode_name(amp_mailbox_mode_t mode)
+{
+    switch (mode) {
+    case AMP_MAILBOX_MODE_SEQUENCED:
+        return "sequenced";
+    case AMP_MAILBOX_MODE_MPSC:
+        return "mpsc";
+    case AMP_MAILBOX_MODE_VARIABLE:
+        return "variable";
+    default:
+        return "indexed";
+    }
+}
+
+/**
+ * Mailbox round-trip latency and streaming throughput
+ */
+static void bench_mailbox(amp_mailbox_mode_t mode, uint32_t msg_size, uint32_t slots,
+                          uint32_t rtt_iters, uint32_t stream_msgs)
+{
+    static char msg[BENCH_MAX_XFER];
+
+    amp_mailbox_config_t config = {
+        .msg_size = msg_size,
+        .msg_slots = slots,
+        .mode = mode
+    };
+    amp_mailbox_t to_core1 = amp_mailbox_create(&config);
+    amp_mailbox_t to_core0 = amp_mailbox_create(&config);
+    if (!to_core1 || !to_core0) {
+        bench_fail("mailbox create");
+    }
+
+    /* Round trip: core 1 echoes every message */
+    bench_start(BENCH_OP_MAILBOX_ECHO, msg_size, rtt_iters, to_core1, to_core0);
+    for (uint32_t i = 0; i < rtt_iters; i++) {
+        uint32_t start = amp_time_cycles();
+        amp_mailbox_send(to_core1, msg, 0);
+        amp_mailbox_recv(to_core0, msg, 0);
+        g_samples[i] = amp_time_cycles() - start;
+    }
+    bench_finish();
+
+    report_begin("mailbox_rtt");
+    report_string("mode", mailbox_mode_name(mode));
+    report_param("msg_size", msg_size);
+    report_param("slots", slots);
+    report_param("iterations", rtt_iters);
+    report_latency(rtt_iters);
+    report_end();
+
+    /* Streaming: core 1 drains as fast as core 0 fills */
+    bench_start(BENCH_OP_MAILBOX_SINK, msg_size, stream_msgs, to_core1, NULL);
+    amp_time_t start = amp_time_now_us();
+    for (uint32_t i = 0; i < stream_msgs; i++) {
+        amp_mailbox_send(to_core1, msg, 0);
+    }
+    bench_finish();
+    amp_time_t elapsed = amp_time_now_us() - start;
+
+    report_begin("mailbox_stream");
+    report_string("mode", mailbox_mode_name(mode));
+    report_param("msg_size", msg_size);
+    report_param("slots", slots);
+    report_param("messages", stream_msgs);
+    report_throughput(stream_msgs, (uint64_t)stream_msgs * msg_size, elapsed);
+    report_end();
+
+    /* Batched streaming: up to a full mailbox per barrier and index update */
+    uint32_t batch = BENCH_MAX_XFER / msg_size;
+    if (batch > slots) {
+        batch = slots;
+    }
+
+    bench_start(BENCH_OP_MAILBOX_BATCH_SINK, msg_size, stream_msgs, to_core1, NULL);
+    start = amp_time_now_us();
+    for (uint32_t i = 0; i < stream_msgs; i += batch) {
+        uint32_t n = stream_msgs - i < batch ? stream_msgs - i : batch;
+        amp_mailbox_send_batch(to_core1, msg, n, 0);
+    }
+    bench_finish();
+    elapsed = amp_time_now_us() - start;
+
+    report_begin("mailbox_stream_batch");
+    report_string("mode", mailbox_mode_name(mode));
+    report_param("msg_size", msg_size);
+    report_param("slots", slots);
+    report_param("batch", batch);
+    report_param("messages", stream_msgs);
+    report_throughput(stream_msgs, (uint64_t)stream_msgs * msg_size, elapsed);
+    report_end();
+}
+
+/**
+ * Streaming throughput of a mailbox that several senders may share
+ * Single-producer modes serialize their senders with a semaphore, MPSC mode
+ * needs no lock; only the per-send cost is measured, as core 0 is the only
+ * sender
+ */
+static void bench_mailbox_shared(amp_mailbox_mode_t mode, uint32_t msg_size, uint32_t slots,
+                                 uint32_t stream_msgs)
+{
+    static char msg[BENCH_MAX_XFER];
+
+    amp_mailbox_config_t config = {
+        .msg_size = msg_size,
+        .msg_slots = slots,
+        .mode = mode
+    };
+    amp_mailbox_t to_core1 = amp_mailbox_create(&config);
+    amp_semaphore_t lock = amp_semaphore_create(1, 1);
+    if (!to_core1 || !lock) {
+        bench_fail("shared mailbox create");
+    }
+
+    int locked = mode != AMP_MAILBOX_MODE_MPSC;
+
+    bench_start(BENCH_OP_MAILBOX_SINK, msg_size, stream_msgs, to_core1, NULL);
+    amp_time_t start = amp_time_now_us();
+    for (uint32_t i = 0; i < stream_msgs; i++) {
+        if (locked) {
+            amp_semaphore_wait(lock, 0);
+        }
+        amp_mailbox_send(to_core1, msg, 0);
+        if (locked) {
+            amp_semaphore_post(lock);
+        }
+    }
+    bench_finish();
+    amp_time_t elapsed = amp_time_now_us() - start;
+
+    report_begin("mailbox_stream_shared");
+    report_string("mode", mailbox_mode_name(mode));
+    report_string("sync", locked ? "semaphore" : "none");
+    report_param("msg_size", msg_size);
+    report_param("slots", slots);
+    report_param("messages", stream_msgs);
+    report_throughput(stream_msgs, (uint64_t)stream_msgs * msg_size, elapsed);
+    report_end();
+}
+
+/**
+ * Streaming throughput of mixed-size traffic
+ * Every eighth message is a 512-byte payload, the rest are 8-byte acks. A
+ * fixed mailbox copies 512 bytes per message; a variable mode mailbox
+ * copies only the bytes in use, from an arena a quarter of the size
+ */
+static void bench_mailbox_mixed(amp_mailbox_mode_t mode, uint32_t stream_msgs)
+{
+    static char msg[512];
+
+    amp_mailbox_config_t config = {
+        .msg_size = sizeof(msg),
+        .msg_slots = 16,
+        .mode = mode,
+        .arena_size = 16 * sizeof(msg) / 4
+    };
+    amp_mailbox_t to_core1 = amp_mailbox_create(&config);
+    if (!to_core1) {
+        bench_fail("mixed mailbox create");
+    }
+
+    int variable = mode == AMP_MAILBOX_MODE_VARIABLE;
+    uint64_t bytes = 0;
+
+    bench_start(variable ? BENCH_OP_MAILBOX_VAR_SINK : BENCH_OP_MAILBOX_SINK,
+                sizeof(msg), stream_msgs, to_core1, NULL);
+    amp_time_t start = amp_time_now_us();
+    for (uint32_t i = 0; i < stream_msgs; i++) {
+        uint32_t len = (i % 8 == 0) ? sizeof(msg) : 8;
+        if (variable) {
+            amp_mailbox_send_var(to_core1, msg, len, 0);
+        } else {
+            amp_mailbox_send(to_core1, msg, 0);
+        }
+        bytes += len;
+    }
+    bench_finish();
+    amp_time_t elapsed = amp_time_now_us() - start;
+
+    report_begin("mailbox_stream_mixed");
+    report_string("mode", mailbox_mode_name(mode));
+    report_param("data_bytes", variable ? config.arena_size : config.msg_slots * config.msg_size);
+    report_param("messages", stream_msgs);
+    report_throughput(stream_msgs, bytes, elapsed);
+    report_end();
+}
+
+/**
+ * Per-message cost of a typed channel against a mailbox of the same geometry
+ * Local: send then receive on core 0, so only the fast path is measured,
+ * also on a channel created without doorbells.
+ * Streaming: core 1 drains the typed channel as fast as core 0 fills it
+ */
+static void bench_channel(uint32_t msg_size, uint32_t local_msgs, uint32_t stream_msgs)
+{
+    static bench_msg16_t msg;
+
+    amp_mailbox_config_t config = {
+        .msg_size = msg_size,
+        .msg_slots = BENCH_CHANNEL_SLOTS
+    };
+    amp_mailbox_t mbox = amp_mailbox_create(&config);
+    bench_chan8_t *chan8 = NULL;
+    bench_chan16_t *chan16 = NULL;
+    bench_chan8_t *polled8 = NULL;
+    bench_chan16_t *polled16 = NULL;
+    void *chan;
+    void *polled;
+    if (msg_size == sizeof(bench_msg8_t)) {
+        chan = chan8 = bench_chan8_create();
+        polled = polled8 = bench_chan8_create_polled();
+    } else {
+        chan = chan16 = bench_chan16_create();
+        polled = polled16 = bench_chan16_create_polled();
+    }
+    if (!mbox || !chan || !polled) {
+        bench_fail("channel create");
+    }
+
+    /* Local send/recv pairs: the copy and index math dominate */
+    amp_time_t start = amp_time_now_us();
+    for (uint32_t i = 0; i < local_msgs; i++) {
+        amp_mailbox_try_send(mbox, &msg);
+        amp_mailbox_try_recv(mbox, &msg);
+    }
+    amp_time_t mailbox_elapsed = amp_time_now_us() - start;
+
+    start = amp_time_now_us();
+    for (uint32_t i = 0; i < local_msgs; i++) {
+        if (chan8) {
+            bench_chan8_try_send(chan8, (bench_msg8_t *)&msg);
+            bench_chan8_try_recv(chan8, (bench_msg8_t *)&msg);
+        } else {
+            bench_chan16_try_send(chan16, &msg);
+            bench_chan16_try_recv(chan16, &msg);
+        }
+    }
+    amp_time_t channel_elapsed = amp_time_now_us() - start;
+
+    /* Same without doorbells: no ring after each publish */
+    start = amp_time_now_us();
+    for (uint32_t i = 0; i < local_msgs; i++) {
+        if (polled8) {
+            bench_chan8_try_send(polled8, (bench_msg8_t *)&msg);
+            bench_chan8_try_recv(polled8, (bench_msg8_t *)&msg);
+        } else {
+            bench_chan16_try_send(polled16, &msg);
+            bench_chan16_try_recv(polled16, &msg);
+        }
+    }
+    amp_time_t polled_elapsed = amp_time_now_us() - start;
+
+    report_begin("channel_local");
+    report_string("api", "mailbox");
+    report_param("msg_size", msg_size);
+    report_param("messages", local_msgs);
+    report_real("ns_per_msg", (double)mailbox_elapsed * 1e3 / local_msgs);
+    report_end();
+
+    report_begin("channel_local");
+    report_string("api", "typed");
+    report_param("msg_size", msg_size);
+    report_param("messages", local_msgs);
+    report_real("ns_per_msg", (double)channel_elapsed * 1e3 / local_msgs);
+    report_end();
+
+    report_begin("channel_local");
+    report_string("api", "typed_polled");
+    report_param("msg_size", msg_size);
+    report_param("messages", local_msgs);
+    report_real("ns_per_msg", (double)polled_elapsed * 1e3 / local_msgs);
+    report_end();
+
+    /* Streaming to core 1 */
+    bench_start(BENCH_OP_CHANNEL_SINK, msg_size, stream_msgs, chan, NULL);
+    start = amp_time_now_us();
+    for (uint32_t i = 0; i < stream_msgs; i++) {
+        if (chan8) {
+            bench_chan8_send(chan8, (bench_msg8_t *)&msg, 0);
+        } else {
+            bench_chan16_send(chan16, &msg, 0);
+        }
+    }
+    bench_finish();
+    amp_time_t elapsed = amp_time_now_us() - start;
+
+    report_begin("channel_stream");
+    report_param("msg_size", msg_size);
+    report_param("slots", BENCH_CHANNEL_SLOTS);
+    report_param("messages", stream_msgs);
+    report_throughput(stream_msgs, (uint64_t)stream_msgs * msg_size, elapsed);
+    report_end();
+}
+
+/**
+ * Ring buffer round-trip latency and streaming throughput
+ */
+static void bench_ringbuf(amp_ringbuf_t to_core1, amp_ringbuf_t to_core0, uint32_t ring_size,
+                          uint32_t chunk, uint32_t rtt_iters, uint32_t stream_chunks)
+{
+    static char data[BENCH_MAX_XFER];
+
+    /* Round trip: core 1 echoes every chunk */
+    bench_start(BENCH_OP_RINGBUF_ECHO, chunk, rtt_iters, to_core1, to_core0);
+    for (uint32_t i = 0; i < rtt_iters; i++) {
+        uint32_t start = amp_time_cycles();
+        ringbuf_write_all(to_core1, data, chunk);
+        ringbuf_read_all(to_core0, data, chunk);
+        g_samples[i] = amp_time_cycles() - start;
+    }
+    bench_finish();
+
+    report_begin("ringbuf_rtt");
+    report_param("ring_size", ring_size);
+    report_param("chunk", chunk);
+    report_param("iterations", rtt_iters);
+    report_latency(rtt_iters);
+    report_end();
+
+    /* Streaming: core 1 drains as fast as core 0 fills */
+    bench_start(BENCH_OP_RINGBUF_SINK, chunk, stream_chunks, to_core1, NULL);
+    amp_time_t start = amp_time_now_us();
+    for (uint32_t i = 0; i < stream_chunks; i++) {
+        ringbuf_write_all(to_core1, data, chunk);
+    }
+    bench_finish();
+    amp_time_t elapsed = amp_time_now_us() - start;
+
+    report_begin("ringbuf_stream");
+    report_param("ring_size", ring_size);
+    report_param("chunk", chunk);
+    report_param("chunks", stream_chunks);
+    report_throughput(stream_chunks, (uint64_t)stream_chunks * chunk, elapsed);
+    report_end();
+}
+
+/**
+ * Single-core ring buffer copy bandwidth
+ * Write then read each chunk on core 0, so only the copy cost is measured
+ */
+static void bench_ringbuf_bandwidth(amp_ringbuf_t rb, uint32_t chunk, uint32_t total_bytes)
+{
+    static char data[BENCH_MAX_XFER];
+
+    uint32_t chunks = total_bytes / chunk;
+
+    amp_time_t start = amp_time_now_us();
+    for (uint32_t i = 0; i < chunks; i++) {
+        amp_ringbuf_write(rb, data, chunk);
+        amp_ringbuf_read(rb, data, chunk);
+    }
+    amp_time_t elapsed = amp_time_now_us() - start;
+
+    /* Every byte crosses the ring twice: in and out */
+    report_begin("ringbuf_bandwidth");
+    report_param("chunk", chunk);
+    report_param("bytes", chunks * chunk);
+    report_throughput(chunks * 2, (uint64_t)chunks * chunk * 2, elapsed);
+    report_end();
+}
+
+/**
+ * Semaphore post/wait round-trip latency
+ */
+static void bench_semaphore(uint32_t rtt_iters)
+{
+    amp_semaphore_t to_core1 = amp_semaphore_create(0, 1);
+    amp_semaphore_t to_core0 = amp_semaphore_create(0, 1);
+    if (!to_core1 || !to_core0) {
+        bench_fail("semaphore create");
+    }
+
+    bench_start(BENCH_OP_SEMAPHORE_ECHO, 0, rtt_iters, to_core1, to_core0);
+    for (uint32_t i = 0; i < rtt_iters; i++) {
+        uint32_t start = amp_time_cycles();
+        amp_semaphore_post(to_core1);
+        amp_semaphore_wait(to_core0, 0);
+        g_samples[i] = amp_time_cycles() - start;
+    }
+    bench_finish();
+
+    report_begin("semaphore_rtt");
+    report_param("iterations", rtt_iters);
+    report_latency(rtt_iters);
+    report_end();
+}
+
+/**
+ * Idle cost and round-trip latency of servicing many channels
+ * The idle check compares one try_recv per channel with one amp_poll_try();
+ * the round trip goes through core 1 blocked in amp_poll() on every channel
+ */
+static void bench_poll(uint32_t channels, uint32_t rtt_iters, uint32_t idle_checks)
+{
+    static char msg[8];
+
+    amp_mailbox_config_t config = {
+        .msg_size = sizeof(msg),
+        .msg_slots = 4
+    };
+    bench_poll_t *poll = amp_shmem_alloc(sizeof(bench_poll_t));
+    amp_mailbox_t to_core0 = amp_mailbox_create(&config);
+    if (!poll || !to_core0) {
+        bench_fail("poll channel create");
+    }
+
+    amp_poll_item_t items[AMP_POLL_MAX_ITEMS];
+    for (uint32_t c = 0; c < channels; c++) {
+        poll->chans[c] = amp_mailbox_create(&config);
+        if (!poll->chans[c]) {
+            bench_fail("poll channel create");
+        }
+        items[c].type = AMP_POLL_MAILBOX;
+        items[c].handle = poll->chans[c];
+    }
+    poll->set = amp_poll_set_create(items, channels);
+    if (!poll->set) {
+        bench_fail("poll set create");
+    }
+
+    /* Idle checks on core 0: every channel is empty */
+    uint32_t found = 0;
+    amp_time_t start = amp_time_now_us();
+    for (uint32_t i = 0; i < idle_checks; i++) {
+        for (uint32_t c = 0; c < channels; c++) {
+            found += amp_mailbox_try_recv(poll->chans[c], msg) == 0;
+        }
+    }
+    amp_time_t scan_elapsed = amp_time_now_us() - start;
+
+    start = amp_time_now_us();
+    for (uint32_t i = 0; i < idle_checks; i++) {
+        found += amp_poll_try(poll->set) != 0;
+    }
+    amp_time_t poll_elapsed = amp_time_now_us() - start;
+
+    if (found != 0) {
+        bench_fail("idle poll");
+    }
+
+    report_begin("poll_idle");
+    report_string("method", "scan");
+    report_param("channels", channels);
+    report_param("checks", idle_checks);
+    report_real("ns_per_check", (double)scan_elapsed * 1e3 / idle_checks);
+    report_end();
+
+    report_begin("poll_idle");
+    report_string("method", "poll");
+    report_param("channels", channels);
+    report_param("checks", idle_checks);
+    report_real("ns_per_check", (double)poll_elapsed * 1e3 / idle_checks);
+    report_end();
+
+    /* Round trip: core 1 polls every channel, core 0 uses the last one */
+    amp_mailbox_t chan = poll->chans[channels - 1];
+    bench_start(BENCH_OP_POLL_ECHO, sizeof(msg), rtt_iters, poll, to_core0);
+    for (uint32_t i = 0; i < rtt_iters; i++) {
+        uint32_t t0 = amp_time_cycles();
+        amp_mailbox_send(chan, msg, 0);
+        amp_mailbox_recv(to_core0, msg, 0);
+        g_samples[i] = amp_time_cycles() - t0;
+    }
+    bench_finish();
+
+    report_begin("poll_rtt");
+    report_param("channels", channels);
+    report_param("iterations", rtt_iters);
+    report_latency(rtt_iters);
+    report_end();
+}
+
+/**
+ * RPC call rate
+ * A window of 1 waits for each response before the next call, like a
+ * hand-coded request/response loop; larger windows keep that many calls in
+ * flight and complete them through callbacks
+ */
+static void bench_rpc(uint32_t window, uint32_t calls)
+{
+    static char req[8];
+    static char resp[8];
+
+    amp_rpc_config_t config = {
+        .max_payload = sizeof(req),
+        .window = window
+    };
+    amp_rpc_t rpc = amp_rpc_create(&config);
+    if (!rpc) {
+        bench_fail("rpc create");
+    }
+
+    uint32_t completed = 0;
+
+    bench_start(BENCH_OP_RPC_SERVE, sizeof(req), calls, rpc, NULL);
+    amp_time_t start = amp_time_now_us();
+    for (uint32_t i = 0; i < calls; i++) {
+        if (window == 1) {
+            uint32_t len;
+            completed += amp_rpc_call(rpc, 0, req, sizeof(req), resp, sizeof(resp), &len,
+                                      BENCH_TIMEOUT_MS) == AMP_RPC_OK;
+        } else if (amp_rpc_call_async(rpc, 0, req, sizeof(req), bench_rpc_done, &completed,
+                                      BENCH_TIMEOUT_MS) != 0) {
+            bench_fail("rpc call");
+        }
+    }
+    if (amp_rpc_drain(rpc, BENCH_TIMEOUT_MS) != 0) {
+        bench_fail("rpc drain");
+    }
+    bench_finish();
+    amp_time_t elapsed = amp_time_now_us() - start;
+
+    if (completed != calls) {
+        bench_fail("rpc completion");
+    }
+
+    report_begin("rpc_calls");
+    report_string("mode", window == 1 ? "sync" : "async");
+    report_param("window", window);
+    report_param("msg_size", sizeof(req));
+    report_param("calls", calls);
+    report_throughput(calls, (uint64_t)calls * sizeof(req), elapsed);
+    report_end();
+}
+
+/**
+ * Wakeup latency and waiter CPU time of a wait policy
+ * Core 1 waits for each request while core 0 works for think_us between
+ * round trips; spinning answers fastest but burns core 1 the whole time.
+ * With word set both cores wait on plain words with amp_wait_on() instead
+ * of on semaphores
+ */
+static void bench_wait(amp_wait_policy_t policy, int word, uint32_t iters, uint32_t think_us)
+{
+    static const char *const policy_names[] = {
+        "default", "spin", "backoff", "sleep", "yield"
+    };
+
+    bench_wait_t *wait = amp_shmem_alloc(sizeof(bench_wait_t));
+    if (!wait) {
+        bench_fail("wait create");
+    }
+    wait->request = amp_semaphore_create(0, 1);
+    wait->response = amp_semaphore_create(0, 1);
+    if (!wait->request || !wait->response) {
+        bench_fail("wait create");
+    }
+    amp_semaphore_set_wait_policy(wait->request, policy);
+    amp_semaphore_set_wait_policy(wait->response, policy);
+    amp_atomic_store_relaxed(&wait->request_seq, 0);
+    amp_atomic_store_relaxed(&wait->response_seq, 0);
+
+    amp_wait_policy_t saved = amp_wait_get_default_policy();
+    if (word) {
+        amp_wait_set_default_policy(policy);
+        bench_start(BENCH_OP_WAIT_ON_ECHO, (uint32_t)policy, iters, wait, NULL);
+    } else {
+        bench_start(BENCH_OP_WAIT_ECHO, 0, iters, wait, NULL);
+    }
+    amp_time_t start = amp_time_now_us();
+    for (uint32_t i = 0; i < iters; i++) {
+        uint32_t t0 = amp_time_cycles();
+        if (word) {
+            amp_atomic_store_release(&wait->request_seq, i + 1);
+            amp_wake(&wait->request_seq);
+            if (amp_wait_on(&wait->response_seq, i, BENCH_TIMEOUT_MS) != 0) {
+                bench_fail("wait_on response");
+            }
+        } else {
+            amp_semaphore_post(wait->request);
+            amp_semaphore_wait(wait->response, 0);
+        }
+        g_samples[i] = amp_time_cycles() - t0;
+
+        amp_time_t busy_until = amp_time_now_us() + think_us;
+        while (amp_time_now_us() < busy_until) {
+        }
+    }
+    bench_finish();
+    amp_time_t elapsed = amp_time_now_us() - start;
+    amp_wait_set_default_policy(saved);
+
+    report_begin("wait_policy");
+    report_string("primitive", word ? "wait_on" : "semaphore");
+    report_string("policy", policy_names[policy]);
+    report_param("think_us", think_us);
+    report_param("iterations", iters);
+    report_real("waiter_cpu_pct", (double)wait->cpu_ns / 10.0 / (double)elapsed);
+    report_latency(iters);
+    report_end();
+}
+
+/**
+ * Snapshot reads of a 200-byte state that core 1 keeps updating
+ * Semaphore readers take the lock around every copy; seqlock readers only
+ * load the sequence number and retry torn copies
+ */
+static void bench_snapshot(int seqlock, uint32_t reads)
+{
+    static uint32_t copy[BENCH_SNAPSHOT_WORDS];
+
+    bench_snapshot_t *snap = amp_shmem_alloc_aligned(sizeof(bench_snapshot_t), 8);
+    if (!snap) {
+        bench_fail("snapshot create");
+    }
+    amp_seqlock_init(&snap->lock);
+    snap->sem = amp_semaphore_create(1, 1);
+    snap->stop = 0;
+    memset(snap->words, 0, sizeof(snap->words));
+    if (!snap->sem) {
+        bench_fail("snapshot create");
+    }
+
+    uint32_t retries = 0;
+    uint32_t torn = 0;
+
+    bench_start(BENCH_OP_SNAPSHOT_WRITE, (uint32_t)seqlock, 0, snap, NULL);
+    amp_time_t start = amp_time_now_us();
+    for (uint32_t i = 0; i < reads; i++) {
+        if (seqlock) {
+            retries += amp_seqlock_read(&snap->lock, copy, snap->words, sizeof(copy));
+        } else {
+            amp_semaphore_wait(snap->sem, 0);
+            memcpy(copy, snap->words, sizeof(copy));
+            amp_semaphore_post(snap->sem);
+        }
+        torn += copy[0] != copy[BENCH_SNAPSHOT_WORDS - 1];
+    }
+    amp_time_t elapsed = amp_time_now_us() - start;
+    snap->stop = 1;
+    bench_finish();
+
+    if (torn != 0) {
+        bench_fail("torn snapshot");
+    }
+
+    report_begin("snapshot_read");
+    report_string("method", seqlock ? "seqlock" : "semaphore");
+    report_param("bytes", sizeof(copy));
+    report_param("reads", reads);
+    report_param("retries", retries);
+    report_param("writer_updates", snap->updates);
+    report_throughput(reads, (uint64_t)reads * sizeof(copy), elapsed);
+    report_end();
+}
+
+/**
+ * Slow consumer of a sample stream that core 1 publishes as fast as it can
+ * The consumer works BENCH_SAMPLE_WORK_US on each sample; age is how many
+ * samples core 1 had published since the one it read
+ */
+static void bench_latest(int latest, uint32_t reads)
+{
+    uint32_t sample[BENCH_SAMPLE_WORDS];
+
+    bench_sample_t *stream = amp_shmem_alloc_aligned(sizeof(bench_sample_t), 8);
+    if (!stream) {
+        bench_fail("sample stream create");
+    }
+    amp_mailbox_config_t cfg = {
+        .msg_size = sizeof(sample),
+        .msg_slots = BENCH_SAMPLE_SLOTS
+    };
+    stream->latest = amp_latest_create(sizeof(sample));
+    stream->mbox = amp_mailbox_create(&cfg);
+    stream->stop = 0;
+    stream->seq = 0;
+    if (!stream->latest || !stream->mbox) {
+        bench_fail("sample stream create");
+    }
+
+    uint64_t age = 0;
+    uint32_t max_age = 0;
+    uint32_t fresh = 0;
+
+    bench_start(BENCH_OP_SAMPLE_PUBLISH, (uint32_t)latest, 0, stream, NULL);
+    amp_time_t start = amp_time_now_us();
+    for (uint32_t i = 0; i < reads; i++) {
+        if (latest) {
+            int rc;
+            while ((rc = amp_latest_read(stream->latest, sample, sizeof(sample), NULL)) < 0) {
+            }
+            fresh += (uint32_t)rc;
+        } else {
+            amp_mailbox_recv(stream->mbox, sample, 0);
+            fresh++;
+        }
+
+        uint32_t behind = stream->seq - sample[0];
+        age += behind;
+        if (behind > max_age) {
+            max_age = behind;
+        }
+
+        amp_time_t work = amp_time_now_us() + BENCH_SAMPLE_WORK_US;
+        while (amp_time_now_us() < work) {
+        }
+    }
+    amp_time_t elapsed = amp_time_now_us() - start;
+    stream->stop = 1;
+    bench_finish();
+
+    report_begin("latest_sample");
+    report_string("method", latest ? "latest" : "mailbox");
+    report_param("bytes", sizeof(sample));
+    report_param("work_us", BENCH_SAMPLE_WORK_US);
+    report_param("reads", reads);
+    report_param("new_samples", fresh);
+    report_param("producer_drops", stream->drops);
+    report_real("age_mean", (double)age / reads);
+    report_param("age_max", max_age);
+    report_throughput(reads, (uint64_t)reads * sizeof(sample), elapsed);
+    report_end();
+}
+
+/**
+ * Round trip in which core 1 signals several conditions and core 0 waits
+ * for all of them
+ * Semaphores take one post and one poll wakeup per condition; an event
+ * group sets them all with one atomic OR and wakes the waiter once
+ */
+static void bench_events(int group, uint32_t iters)
+{
+    const uint32_t all = (1u << BENCH_EVENT_CONDITIONS) - 1;
+
+    bench_events_t *events = amp_shmem_alloc(sizeof(bench_events_t));
+    if (!events) {
+        bench_fail("events create");
+    }
+    events->go = amp_semaphore_create(0, 1);
+    events->group = amp_event_group_create(0);
+    if (!events->go || !events->group) {
+        bench_fail("events create");
+    }
+
+    amp_poll_item_t items[BENCH_EVENT_CONDITIONS];
+    for (uint32_t c = 0; c < BENCH_EVENT_CONDITIONS; c++) {
+        events->sems[c] = amp_semaphore_create(0, 1);
+        if (!events->sems[c]) {
+            bench_fail("events create");
+        }
+        items[c].type = AMP_POLL_SEMAPHORE;
+        items[c].handle = events->sems[c];
+    }
+    amp_poll_set_t set = amp_poll_set_create(items, BENCH_EVENT_CONDITIONS);
+    if (!set) {
+        bench_fail("poll set create");
+    }
+
+    bench_start(BENCH_OP_EVENT_SIGNAL, (uint32_t)group, iters, events, NULL);
+    for (uint32_t i = 0; i < iters; i++) {
+        uint32_t t0 = amp_time_cycles();
+        amp_semaphore_post(events->go);
+        if (group) {
+            if (amp_event_group_wait_bits(events->group, all, AMP_EVENT_WAIT_ALL, true,
+                                          BENCH_TIMEOUT_MS) == 0) {
+                bench_fail("event group wait");
+            }
+        } else {
+            uint32_t pending = all;
+            while (pending) {
+                uint32_t ready = amp_poll(set, BENCH_TIMEOUT_MS) & pending;
+                if (!ready) {
+                    bench_fail("events poll");
+                }
+                for (uint32_t c = 0; c < BENCH_EVENT_CONDITIONS; c++) {
+                    if ((ready & (1u << c)) && amp_semaphore_try_wait(events->sems[c]) == 0) {
+                        pending &= ~(1u << c);
+                    }
+                }
+            }
+        }
+        g_samples[i] = amp_time_cycles() - t0;
+    }
+    bench_finish();
+    amp_poll_set_destroy(set);
+
+    report_begin("event_signal");
+    report_string("method", group ? "event_group" : "semaphores");
+    report_param("conditions", BENCH_EVENT_CONDITIONS);
+    report_param("iterations", iters);
+    report_latency(iters);
+    report_end();
+}
+
+/**
+ * Main function - runs on Core 0
+ */
+int main(int argc, char **argv)
+{
+    static const amp_mailbox_mode_t mailbox_modes[] = {
+        AMP_MAILBOX_MODE_INDEXED, AMP_MAILBOX_MODE_SEQUENCED
+    };
+    static const amp_mailbox_mode_t shared_modes[] = {
+        AMP_MAILBOX_MODE_INDEXED, AMP_MAILBOX_MODE_SEQUENCED, AMP_MAILBOX_MODE_MPSC
+    };
+    static const uint32_t msg_sizes[] = { 8, 64, 256, 1024 };
+    static const uint32_t channel_sizes[] = { sizeof(bench_msg8_t), sizeof(bench_msg16_t) };
+    static const uint32_t slot_counts[] = { 4, 16, 64 };
+    static const uint32_t ring_sizes[] = { 1024, 16384, 65536 };
+    static const uint32_t chunk_sizes[] = { 16, 256, 4096 };
+    static const uint32_t bandwidth_chunks[] = { 16, 256, 4096 };
+    static const uint32_t poll_channels[] = { 1, 4, 12, 32 };
+    static const uint32_t rpc_windows[] = { 1, 4, 16, 64 };
+    static const amp_wait_policy_t wait_policies[] = {
+        AMP_WAIT_SPIN, AMP_WAIT_BACKOFF, AMP_WAIT_SLEEP, AMP_WAIT_YIELD
+    };
+
+    uint32_t rtt_iters = 10000;
+    uint32_t stream_msgs = 100000;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        uint32_t value = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        if (strcmp(argv[i], "-n") == 0 && value > 0) {
+            rtt_iters = value;
+        } else if (strcmp(argv[i], "-t") == 0 && value > 0) {
+            stream_msgs = value;
+        } else if (strcmp(argv[i], "-s") == 0) {
+            g_suite = argv[i + 1];
+        } else {
+            fprintf(stderr, "usage: %s [-n rtt_iterations] [-t stream_messages] [-s suite]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+
+    g_samples = malloc(rtt_iters * sizeof(g_samples[0]));
+    if (!g_samples) {
+        bench_fail("sample buffer");
+    }
+
+    if (amp_shmem_init((void *)SHMEM_BASE, SHMEM_SIZE) != 0) {
+        bench_fail("shared memory init");
+    }
+
+    if (amp_boot_init() != AMP_BOOT_SUCCESS) {
+        bench_fail("boot init");
+    }
+
+    amp_mailbox_config_t ctl_config = {
+        .msg_size = sizeof(bench_cmd_t),
+        .msg_slots = 2
+    };
+    g_ctl_to_core1 = amp_mailbox_create(&ctl_config);
+    g_ctl_to_core0 = amp_mailbox_create(&ctl_config);
+    if (!g_ctl_to_core1 || !g_ctl_to_core0) {
+        bench_fail("control mailbox create");
+    }
+
+    amp_boot_core(AMP_CORE1, (uint32_t)(uintptr_t)core1_main, 0);
+    if (amp_boot_wait_core_ready(AMP_CORE1, BENCH_TIMEOUT_MS) != AMP_BOOT_SUCCESS) {
+        bench_fail("core 1 boot");
+    }
+
+    printf("{\n  \"platform\": \"%s\",\n  \"layout\": \"%s\",\n  \"results\": [",
+           AMP_BENCH_PLATFORM, BENCH_LAYOUT);
+
+    if (suite_enabled("mailbox")) {
+        for (size_t m = 0; m < sizeof(mailbox_modes) / sizeof(mailbox_modes[0]); m++) {
+            for (size_t s = 0; s < sizeof(msg_sizes) / sizeof(msg_sizes[0]); s++) {
+                for (size_t k = 0; k < sizeof(slot_counts) / sizeof(slot_counts[0]); k++) {
+                    bench_mailbox(mailbox_modes[m], msg_sizes[s], slot_counts[k],
+                                  rtt_iters, stream_msgs);
+                }
+            }
+        }
+
+        bench_mailbox_mixed(AMP_MAILBOX_MODE_INDEXED, stream_msgs);
+        bench_mailbox_mixed(AMP_MAILBOX_MODE_VARIABLE, stream_msgs);
+
+        for (size_t m = 0; m < sizeof(shared_modes) / sizeof(shared_modes[0]); m++) {
+            for (size_t s = 0; s < sizeof(msg_sizes) / sizeof(msg_sizes[0]); s++) {
+                bench_mailbox_shared(shared_modes[m], msg_sizes[s], 16, stream_msgs);
+            }
+        }
+    }
+
+    if (suite_enabled("channel")) {
+        for (size_t s = 0; s < sizeof(channel_sizes) / sizeof(channel_sizes[0]); s++) {
+            bench_channel(channel_sizes[s], stream_msgs * 10, stream_msgs);
+        }
+    }
+
+    if (suite_enabled("ringbuf")) {
+        for (size_t r = 0; r < sizeof(ring_sizes) / sizeof(ring_sizes[0]); r++) {
+            /* Rings are drained after every run, so each size is reused */
+            amp_ringbuf_t to_core1 = amp_ringbuf_create(ring_sizes[r]);
+            amp_ringbuf_t to_core0 = amp_ringbuf_create(ring_sizes[r]);
+            if (!to_core1 || !to_core0) {
+                bench_fail("ringbuf create");
+            }
+
+            for (size_t c = 0; c < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); c++) {
+                if (chunk_sizes[c] <= ring_sizes[r]) {
+                    bench_ringbuf(to_core1, to_core0, ring_sizes[r], chunk_sizes[c],
+                                  rtt_iters, stream_msgs);
+                }
+            }
+        }
+    }
+
+    if (suite_enabled("semaphore")) {
+        bench_semaphore(rtt_iters);
+    }
+
+    if (suite_enabled("poll")) {
+        for (size_t c = 0; c < sizeof(poll_channels) / sizeof(poll_channels[0]); c++) {
+            bench_poll(poll_channels[c], rtt_iters, stream_msgs);
+        }
+    }
+
+    if (suite_enabled("rpc")) {
+        for (size_t w = 0; w < sizeof(rpc_windows) / sizeof(rpc_windows[0]); w++) {
+            bench_rpc(rpc_windows[w], stream_msgs);
+        }
+    }
+
+    if (suite_enabled("wait")) {
+        for (size_t w = 0; w < sizeof(wait_policies) / sizeof(wait_policies[0]); w++) {
+            bench_wait(wait_policies[w], 0, rtt_iters / 10 + 1, 50);
+            bench_wait(wait_policies[w], 1, rtt_iters / 10 + 1, 50);
+        }
+    }
+
+    if (suite_enabled("snapshot")) {
+        bench_snapshot(0, stream_msgs);
+        bench_snapshot(1, stream_msgs);
+    }
+
+    if (suite_enabled("latest")) {
+        bench_latest(0, stream_msgs / 10);
+        bench_latest(1, stream_msgs / 10);
+    }
+
+    if (suite_enabled("events")) {
+        bench_events(0, rtt_iters);
+        bench_events(1, rtt_iters);
+    }
+
+    if (suite_enabled("bandwidth")) {
+        /* Odd ring start offset so chunks also straddle the wrap */
+        amp_ringbuf_t bw_ring = amp_ringbuf_create(BENCH_MAX_XFER * 4);
+        if (!bw_ring) {
+            bench_fail("ringbuf create");
+        }
+        amp_ringbuf_write(bw_ring, "bench", 5);
+        amp_ringbuf_clear(bw_ring);
+
+        for (size_t c = 0; c < sizeof(bandwidth_chunks) / sizeof(bandwidth_chunks[0]); c++) {
+            bench_ringbuf_bandwidth(bw_ring, bandwidth_chunks[c], stream_msgs * 256);
+        }
+    }
+
+    printf("\n  ]\n}\n");
+
+    free(g_samples);
+
+    return 0;
+}
@@ -0,0 +1,18 @@
+# Host Process Platform Configuration
+# Multi-core simulation on a Linux host: each core runs as its own process
+# and the cores share only a named POSIX shared memory segment
+
+message(STATUS "Using host-process platform configuration")
+
+# Platform definitions
+# SHMEM_BASE is backed by the mapped shm_open() segment
+add_compile_definitions(
+    AMP_PLATFORM_HOST
+    AMP_PLATFORM_HOST_PROCESS
+    "SHMEM_BASE=amp_host_shmem_base()"
+)
+
+# Entry points are passed as 32-bit addresses (see amp_boot_core()), so
+# images are linked position-dependent to keep code below 4GB
+add_compile_options(-fno-pie)
+add_link_options(-no-pie)
@@ -0,0 +1,20 @@
+# Host Threads Platform Configuration
+# Multi-core simulation on a Linux/POSIX host: each secondary core runs on
+# its own OS thread pinned to a separate CPU
+
+message(STATUS "Using host-threads platform configuration")
+
+find_package(Threads REQUIRED)
+
+# Platform definitions
+# SHMEM_BASE is backed by a real allocation instead of a fixed SRAM address
+add_compile_definitions(
+    AMP_PLATFORM_HOST
+    AMP_PLATFORM_HOST_THREADS
+    "SHMEM_BASE=amp_host_shmem_base()"
+)
+
+# Entry points are passed as 32-bit addresses (see amp_boot_core()), so
+# images are linked position-dependent to keep code below 4GB
+add_compile_options(-fno-pie)
+add_link_options(-no-pie)
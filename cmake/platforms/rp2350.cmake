@@ -3,6 +3,12 @@
 
 message(STATUS "Using RP2350 platform configuration")
 
+# Platform definitions (selects RP2350 boot path and TIMER0 time base)
+add_compile_definitions(PLATFORM_RP2350)
+
+# newlib-nano memcpy copies bytes; use the word copy kernel for IPC payloads
+set(AMP_COPY_KERNEL "word" CACHE STRING "Shared memory copy kernel (memcpy, word)")
+
 # This file can be extended with:
 # - Pico SDK integration
 # - RP2350-specific compiler flags
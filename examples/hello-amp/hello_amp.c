@@ -30,8 +30,9 @@ typedef struct {
     char message[56];
 } hello_msg_t;
 
-/* Shared mailbox */
-static amp_mailbox_t g_mailbox = NULL;
+/* Shared mailboxes - one for each direction */
+static amp_mailbox_t g_mbox_to_core0 = NULL;
+static amp_mailbox_t g_mbox_to_core1 = NULL;
 
 /**
  * Core 1 entry point
@@ -49,13 +50,13 @@ void core1_main(void)
     };
     snprintf(msg.message, sizeof(msg.message), "Hello from Core 1!");
 
-    if (amp_mailbox_send(g_mailbox, &msg, 1000) == 0) {
+    if (amp_mailbox_send(g_mbox_to_core0, &msg, 1000) == 0) {
         printf("Core 1: Message sent to Core 0\n");
     }
 
     /* Wait for response */
     hello_msg_t response;
-    if (amp_mailbox_recv(g_mailbox, &response, 1000) == 0) {
+    if (amp_mailbox_recv(g_mbox_to_core1, &response, 1000) == 0) {
         printf("Core 1: Received: '%s' from Core %u\n", 
                response.message, response.core_id);
     }
@@ -92,14 +93,15 @@ int main(void)
         return 1;
     }
 
-    /* Create mailbox for communication */
+    /* Create mailboxes for communication */
     amp_mailbox_config_t mbox_config = {
         .msg_size = sizeof(hello_msg_t),
         .msg_slots = 4
     };
-    g_mailbox = amp_mailbox_create(&mbox_config);
-    if (!g_mailbox) {
-        printf("Core 0: Failed to create mailbox\n");
+    g_mbox_to_core0 = amp_mailbox_create(&mbox_config);
+    g_mbox_to_core1 = amp_mailbox_create(&mbox_config);
+    if (!g_mbox_to_core0 || !g_mbox_to_core1) {
+        printf("Core 0: Failed to create mailboxes\n");
         return 1;
     }
 
@@ -125,7 +127,7 @@ int main(void)
 
     /* Receive message from core 1 */
     hello_msg_t msg;
-    if (amp_mailbox_recv(g_mailbox, &msg, 1000) == 0) {
+    if (amp_mailbox_recv(g_mbox_to_core0, &msg, 1000) == 0) {
         printf("Core 0: Received: '%s' from Core %u\n", 
                msg.message, msg.core_id);
     }
@@ -136,7 +138,7 @@ int main(void)
     };
     snprintf(response.message, sizeof(response.message), "Hello from Core 0!");
     
-    if (amp_mailbox_send(g_mailbox, &response, 1000) == 0) {
+    if (amp_mailbox_send(g_mbox_to_core1, &response, 1000) == 0) {
         printf("Core 0: Response sent to Core 1\n");
     }
 
@@ -6,93 +6,18 @@
  * - Bidirectional communication using mailboxes
  * - Message sequencing and acknowledgment
  * - Continuous inter-core message exchange
+ * - Handing shared objects to core 1 through the shared memory root, which
+ *   also works when core 1 runs a separate image (pingpong_core1.c)
  */
 
+#include "pingpong.h"
 #include "amp_boot.h"
 #include "amp_config.h"
-#include "amp_mailbox.h"
 #include "amp_shmem.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdint.h>
 
-/* Shared memory configuration */
-#ifndef SHMEM_BASE
-#define SHMEM_BASE 0x20040000
-#endif
-#ifndef SHMEM_SIZE
-#define SHMEM_SIZE (16 * 1024)
-#endif
-
-#define PING_PONG_COUNT 10
-
-/* Message types */
-typedef enum {
-    MSG_PING,
-    MSG_PONG,
-    MSG_DONE
-} msg_type_t;
-
-/* Message structure */
-typedef struct {
-    msg_type_t type;
-    uint32_t sequence;
-    uint32_t core_id;
-} pingpong_msg_t;
-
-/* Shared mailboxes - one for each direction */
-static amp_mailbox_t g_mbox_to_core1 = NULL;
-static amp_mailbox_t g_mbox_to_core0 = NULL;
-
-/**
- * Core 1 entry point
- */
-void core1_main(void)
-{
-    amp_boot_signal_ready();
-    printf("Core 1: Starting ping-pong receiver\n");
-
-    for (int i = 0; i < PING_PONG_COUNT; i++) {
-        /* Wait for PING from Core 0 */
-        pingpong_msg_t msg;
-        if (amp_mailbox_recv(g_mbox_to_core1, &msg, 2000) == 0) {
-            if (msg.type == MSG_PING) {
-                printf("Core 1: Received PING #%u\n", msg.sequence);
-
-                /* Send PONG response */
-                pingpong_msg_t pong = {
-                    .type = MSG_PONG,
-                    .sequence = msg.sequence,
-                    .core_id = 1
-                };
-                
-                amp_mailbox_send(g_mbox_to_core0, &pong, 1000);
-                printf("Core 1: Sent PONG #%u\n", pong.sequence);
-            }
-        } else {
-            printf("Core 1: Timeout waiting for PING\n");
-            break;
-        }
-    }
-
-    /* Send completion message */
-    pingpong_msg_t done = {
-        .type = MSG_DONE,
-        .sequence = 0,
-        .core_id = 1
-    };
-    amp_mailbox_send(g_mbox_to_core0, &done, 1000);
-    printf("Core 1: Ping-pong complete\n");
-
-    while (1) {
-#if defined(__ARM_ARCH) || defined(__arm__)
-        __asm__ volatile("wfi");
-#else
-        /* Busy wait on non-ARM platforms */
-#endif
-    }
-}
-
 /**
  * Main function - runs on Core 0
  */
@@ -119,14 +44,26 @@ int main(void)
         .msg_slots = 4
     };
 
-    g_mbox_to_core1 = amp_mailbox_create(&mbox_config);
-    g_mbox_to_core0 = amp_mailbox_create(&mbox_config);
+    pingpong_shared_t *shared = amp_shmem_alloc(sizeof(pingpong_shared_t));
+    if (!shared) {
+        printf("Core 0: Failed to allocate shared state\n");
+        return 1;
+    }
+
+    shared->to_core1 = amp_mailbox_create(&mbox_config);
+    shared->to_core0 = amp_mailbox_create(&mbox_config);
 
-    if (!g_mbox_to_core1 || !g_mbox_to_core0) {
+    if (!shared->to_core1 || !shared->to_core0) {
         printf("Core 0: Failed to create mailboxes\n");
         return 1;
     }
 
+    /* Publish the mailboxes before core 1 starts looking for them */
+    if (amp_shmem_set_root(shared) != 0) {
+        printf("Core 0: Failed to publish shared state\n");
+        return 1;
+    }
+
     printf("Core 0: Starting Core 1...\n");
 
     /* Boot core 1 */
@@ -154,7 +91,7 @@ int main(void)
             .core_id = 0
         };
 
-        if (amp_mailbox_send(g_mbox_to_core1, &ping, 1000) != 0) {
+        if (amp_mailbox_send(shared->to_core1, &ping, 1000) != 0) {
             printf("Core 0: Failed to send PING #%u\n", i);
             break;
         }
@@ -162,7 +99,7 @@ int main(void)
 
         /* Wait for PONG */
         pingpong_msg_t pong;
-        if (amp_mailbox_recv(g_mbox_to_core0, &pong, 2000) == 0) {
+        if (amp_mailbox_recv(shared->to_core0, &pong, 2000) == 0) {
             if (pong.type == MSG_PONG && pong.sequence == i) {
                 printf("Core 0: Received PONG #%u\n", pong.sequence);
             }
@@ -174,7 +111,7 @@ int main(void)
 
     /* Wait for done message */
     pingpong_msg_t msg;
-    if (amp_mailbox_recv(g_mbox_to_core0, &msg, 2000) == 0) {
+    if (amp_mailbox_recv(shared->to_core0, &msg, 2000) == 0) {
         if (msg.type == MSG_DONE) {
             printf("Core 0: Received completion from Core 1\n");
         }
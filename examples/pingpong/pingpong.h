@@ -0,0 +1,49 @@
+/**
+ * @file pingpong.h
+ * @brief Ping-Pong Example - State shared by both cores
+ */
+
+#ifndef PINGPONG_H
+#define PINGPONG_H
+
+#include "amp_mailbox.h"
+#include <stdint.h>
+
+/* Shared memory configuration */
+#ifndef SHMEM_BASE
+#define SHMEM_BASE 0x20040000
+#endif
+#ifndef SHMEM_SIZE
+#define SHMEM_SIZE (16 * 1024)
+#endif
+
+#define PING_PONG_COUNT 10
+
+/* Message types */
+typedef enum {
+    MSG_PING,
+    MSG_PONG,
+    MSG_DONE
+} msg_type_t;
+
+/* Message structure */
+typedef struct {
+    msg_type_t type;
+    uint32_t sequence;
+    uint32_t core_id;
+} pingpong_msg_t;
+
+/* Shared mailboxes - one for each direction
+ * Published as the shared memory root, so a separate core 1 image finds them
+ */
+typedef struct {
+    amp_mailbox_t to_core1;
+    amp_mailbox_t to_core0;
+} pingpong_shared_t;
+
+/**
+ * Core 1 entry point
+ */
+void core1_main(void);
+
+#endif /* PINGPONG_H */
@@ -0,0 +1,88 @@
+/**
+ * @file pingpong_core1.c
+ * @brief Ping-Pong Example - Core 1 receiver
+ *
+ * Linked into the pingpong image, which boots it as core1_main(). Built
+ * with PINGPONG_CORE1_IMAGE it is a separate core 1 image instead: run
+ * pingpong with AMP_HOST_CORE1_IMAGE pointing at it on the host-process
+ * platform.
+ */
+
+#include "pingpong.h"
+#include "amp_boot.h"
+#include "amp_shmem.h"
+#include <stdio.h>
+
+/**
+ * Core 1 entry point
+ */
+void core1_main(void)
+{
+    /* No globals are shared with core 0: take the mailboxes from the root */
+    const pingpong_shared_t *shared = amp_shmem_get_root();
+    if (!shared) {
+        printf("Core 1: No shared state published\n");
+        return;
+    }
+
+    amp_boot_signal_ready();
+    printf("Core 1: Starting ping-pong receiver\n");
+
+    for (int i = 0; i < PING_PONG_COUNT; i++) {
+        /* Wait for PING from Core 0 */
+        pingpong_msg_t msg;
+        if (amp_mailbox_recv(shared->to_core1, &msg, 2000) == 0) {
+            if (msg.type == MSG_PING) {
+                printf("Core 1: Received PING #%u\n", msg.sequence);
+
+                /* Send PONG response */
+                pingpong_msg_t pong = {
+                    .type = MSG_PONG,
+                    .sequence = msg.sequence,
+                    .core_id = 1
+                };
+
+                amp_mailbox_send(shared->to_core0, &pong, 1000);
+                printf("Core 1: Sent PONG #%u\n", pong.sequence);
+            }
+        } else {
+            printf("Core 1: Timeout waiting for PING\n");
+            break;
+        }
+    }
+
+    /* Send completion message */
+    pingpong_msg_t done = {
+        .type = MSG_DONE,
+        .sequence = 0,
+        .core_id = 1
+    };
+    amp_mailbox_send(shared->to_core0, &done, 1000);
+    printf("Core 1: Ping-pong complete\n");
+
+    while (1) {
+#if defined(__ARM_ARCH) || defined(__arm__)
+        __asm__ volatile("wfi");
+#else
+        /* Busy wait on non-ARM platforms */
+#endif
+    }
+}
+
+#ifdef PINGPONG_CORE1_IMAGE
+/**
+ * Main function of the separate core 1 image
+ */
+int main(void)
+{
+    /* Join the pool core 0 initialized, without clearing it */
+    if (amp_shmem_attach((void *)SHMEM_BASE, SHMEM_SIZE) != 0) {
+        printf("Core 1: Failed to attach to shared memory\n");
+        return 1;
+    }
+
+    core1_main();
+
+    return 0;
+}
+#endif
@@ -6,13 +6,16 @@
  * - Shared memory access from multiple cores
  * - Semaphore-based synchronization
  * - Atomic operations and memory barriers
+ * - Ticket and MCS spinlock throughput against the semaphore
  */
 
 #include "amp_boot.h"
 #include "amp_config.h"
 #include "amp_semaphore.h"
 #include "amp_shmem.h"
+#include "amp_spinlock.h"
 #include "amp_barriers.h"
+#include "amp_time.h"
 #include <stdio.h>
 #include <stdint.h>
 
@@ -26,6 +29,19 @@
 
 #define INCREMENT_COUNT 100
 
+/* Increments per core for each lock in the comparison */
+#define COMPARE_COUNT 10000
+
+/* Locks compared after the main run */
+typedef enum {
+    LOCK_SEMAPHORE,
+    LOCK_TICKET,
+    LOCK_MCS,
+    LOCK_TYPE_COUNT
+} lock_type_t;
+
+static const char *const lock_names[LOCK_TYPE_COUNT] = { "semaphore", "ticket", "mcs" };
+
 /* Shared counter structure */
 typedef struct {
     volatile uint32_t counter;
@@ -36,6 +52,10 @@ typedef struct {
 /* Global shared resources */
 static shared_counter_t *g_shared_counter = NULL;
 static amp_semaphore_t g_counter_sem = NULL;
+static amp_spinlock_t g_ticket_lock = NULL;
+static amp_spinlock_t g_mcs_lock = NULL;
+static amp_semaphore_t g_round_start = NULL;
+static amp_semaphore_t g_round_done = NULL;
 
 /**
  * Increment the shared counter safely
@@ -66,6 +86,54 @@ static void increment_counter(uint32_t core_id)
     amp_semaphore_post(g_counter_sem);
 }
 
+/**
+ * Take one of the compared locks
+ */
+static void lock_acquire(lock_type_t type)
+{
+    switch (type) {
+    case LOCK_SEMAPHORE:
+        amp_semaphore_wait(g_counter_sem, 0);
+        break;
+    case LOCK_TICKET:
+        amp_spinlock_lock(g_ticket_lock);
+        break;
+    default:
+        amp_spinlock_lock(g_mcs_lock);
+        break;
+    }
+}
+
+/**
+ * Release one of the compared locks
+ */
+static void lock_release(lock_type_t type)
+{
+    switch (type) {
+    case LOCK_SEMAPHORE:
+        amp_semaphore_post(g_counter_sem);
+        break;
+    case LOCK_TICKET:
+        amp_spinlock_unlock(g_ticket_lock);
+        break;
+    default:
+        amp_spinlock_unlock(g_mcs_lock);
+        break;
+    }
+}
+
+/**
+ * Increment the counter COMPARE_COUNT times under one lock type
+ */
+static void compare_round(lock_type_t type)
+{
+    for (int i = 0; i < COMPARE_COUNT; i++) {
+        lock_acquire(type);
+        g_shared_counter->counter++;
+        lock_release(type);
+    }
+}
+
 /**
  * Core 1 entry point
  */
@@ -87,6 +155,16 @@ void core1_main(void)
     printf("Core 1: Finished all increments\n");
     printf("Core 1: Counter value = %u\n", g_shared_counter->counter);
 
+    /* Tell core 0 the increments are done */
+    amp_semaphore_post(g_round_done);
+
+    /* Lock comparison: one round per lock type, started by core 0 */
+    for (int type = 0; type < LOCK_TYPE_COUNT; type++) {
+        amp_semaphore_wait(g_round_start, 0);
+        compare_round((lock_type_t)type);
+        amp_semaphore_post(g_round_done);
+    }
+
     while (1) {
 #if defined(__ARM_ARCH) || defined(__arm__)
         __asm__ volatile("wfi");
@@ -135,6 +213,16 @@ int main(void)
         return 1;
     }
 
+    /* Locks and round signals for the lock comparison */
+    g_ticket_lock = amp_spinlock_create(AMP_SPINLOCK_TICKET);
+    g_mcs_lock = amp_spinlock_create(AMP_SPINLOCK_MCS);
+    g_round_start = amp_semaphore_create(0, 1);
+    g_round_done = amp_semaphore_create(0, 1);
+    if (!g_ticket_lock || !g_mcs_lock || !g_round_start || !g_round_done) {
+        printf("Core 0: Failed to create comparison locks\n");
+        return 1;
+    }
+
     printf("Core 0: Starting Core 1...\n");
 
     /* Boot core 1 */
@@ -165,8 +253,11 @@ int main(void)
 
     printf("Core 0: Finished all increments\n");
 
-    /* Wait a bit for Core 1 to finish */
-    for (volatile int i = 0; i < 1000000; i++);
+    /* Wait for Core 1 to finish */
+    if (amp_semaphore_wait(g_round_done, 10000) != 0) {
+        printf("Core 0: Timeout waiting for Core 1\n");
+        return 1;
+    }
 
     /* Display results */
     printf("\n=== Results ===\n");
@@ -181,6 +272,27 @@ int main(void)
         printf("ERROR: Counter value mismatch!\n");
     }
 
+    /* Both cores contend for each lock in turn */
+    printf("\n=== Lock Comparison ===\n");
+    for (int type = 0; type < LOCK_TYPE_COUNT; type++) {
+        g_shared_counter->counter = 0;
+        AMP_DMB();
+
+        amp_time_t start = amp_time_now_us();
+        amp_semaphore_post(g_round_start);
+        compare_round((lock_type_t)type);
+        if (amp_semaphore_wait(g_round_done, 10000) != 0) {
+            printf("Core 0: Timeout waiting for Core 1\n");
+            return 1;
+        }
+        uint32_t elapsed_us = (uint32_t)(amp_time_now_us() - start);
+
+        printf("%-10s %u increments in %u us (%u ns each) %s\n", lock_names[type],
+               g_shared_counter->counter, elapsed_us,
+               (uint32_t)((uint64_t)elapsed_us * 1000u / (COMPARE_COUNT * 2)),
+               g_shared_counter->counter == COMPARE_COUNT * 2 ? "OK" : "ERROR");
+    }
+
     printf("===============================\n");
 
     return 0;
@@ -0,0 +1,225 @@
+/**
+ * @file amp_atomic.h
+ * @brief C11 Atomics for Shared Control Blocks
+ *
+ * Thin layer over <stdatomic.h> naming the orderings the IPC primitives
+ * need. A side publishes data with a release store of its own index and
+ * observes the other side's data with an acquire load of the remote index,
+ * so no full barrier sits on the hot path: on x86 both are plain moves, on
+ * ARMv8 the compiler emits LDA/STL, and on ARMv7 a single DMB.
+ *
+ * Fields accessed through this layer are declared amp_atomic_u32_t. The
+ * header is public because AMP_DEFINE_CHANNEL expands in user code; C++
+ * has no _Atomic before C++23, so there the same word goes through the
+ * GCC/Clang __atomic builtins.
+ */
+
+#ifndef AMP_ATOMIC_H
+#define AMP_ATOMIC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+
+/* 32-bit word shared between cores */
+typedef uint32_t amp_atomic_u32_t;
+
+/* Pointer shared between cores (same address in every core image) */
+typedef void *amp_atomic_ptr_t;
+
+#define AMP_ATOMIC_RELAXED __ATOMIC_RELAXED
+#define AMP_ATOMIC_ACQUIRE __ATOMIC_ACQUIRE
+#define AMP_ATOMIC_RELEASE __ATOMIC_RELEASE
+#define AMP_ATOMIC_ACQ_REL __ATOMIC_ACQ_REL
+#define AMP_ATOMIC_SEQ_CST __ATOMIC_SEQ_CST
+
+#define AMP_ATOMIC_LOAD(p, order) __atomic_load_n(p, order)
+#define AMP_ATOMIC_STORE(p, value, order) __atomic_store_n(p, value, order)
+#define AMP_ATOMIC_FETCH_ADD(p, value, order) __atomic_fetch_add(p, value, order)
+#define AMP_ATOMIC_FETCH_SUB(p, value, order) __atomic_fetch_sub(p, value, order)
+#define AMP_ATOMIC_FETCH_OR(p, value, order) __atomic_fetch_or(p, value, order)
+#define AMP_ATOMIC_FETCH_AND(p, value, order) __atomic_fetch_and(p, value, order)
+#define AMP_ATOMIC_EXCHANGE(p, value, order) __atomic_exchange_n(p, value, order)
+#define AMP_ATOMIC_CAS(p, expected, desired, success, failure) \
+    __atomic_compare_exchange_n(p, expected, desired, false, success, failure)
+#define AMP_ATOMIC_FENCE(order) __atomic_thread_fence(order)
+
+#else
+
+#include <stdatomic.h>
+
+/* 32-bit word shared between cores */
+typedef _Atomic uint32_t amp_atomic_u32_t;
+
+/* Pointer shared between cores (same address in every core image) */
+typedef void *_Atomic amp_atomic_ptr_t;
+
+#define AMP_ATOMIC_RELAXED memory_order_relaxed
+#define AMP_ATOMIC_ACQUIRE memory_order_acquire
+#define AMP_ATOMIC_RELEASE memory_order_release
+#define AMP_ATOMIC_ACQ_REL memory_order_acq_rel
+#define AMP_ATOMIC_SEQ_CST memory_order_seq_cst
+
+#define AMP_ATOMIC_LOAD(p, order) atomic_load_explicit(p, order)
+#define AMP_ATOMIC_STORE(p, value, order) atomic_store_explicit(p, value, order)
+#define AMP_ATOMIC_FETCH_ADD(p, value, order) atomic_fetch_add_explicit(p, value, order)
+#define AMP_ATOMIC_FETCH_SUB(p, value, order) atomic_fetch_sub_explicit(p, value, order)
+#define AMP_ATOMIC_FETCH_OR(p, value, order) atomic_fetch_or_explicit(p, value, order)
+#define AMP_ATOMIC_FETCH_AND(p, value, order) atomic_fetch_and_explicit(p, value, order)
+#define AMP_ATOMIC_EXCHANGE(p, value, order) atomic_exchange_explicit(p, value, order)
+#define AMP_ATOMIC_CAS(p, expected, desired, success, failure) \
+    atomic_compare_exchange_strong_explicit(p, expected, desired, success, failure)
+#define AMP_ATOMIC_FENCE(order) atomic_thread_fence(order)
+
+#endif /* __cplusplus */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Load a word with no ordering (own index, statistics)
+ */
+static inline uint32_t amp_atomic_load_relaxed(const amp_atomic_u32_t *p)
+{
+    return AMP_ATOMIC_LOAD(p, AMP_ATOMIC_RELAXED);
+}
+
+/**
+ * Load a word; later accesses stay after it (remote index)
+ */
+static inline uint32_t amp_atomic_load_acquire(const amp_atomic_u32_t *p)
+{
+    return AMP_ATOMIC_LOAD(p, AMP_ATOMIC_ACQUIRE);
+}
+
+/**
+ * Store a word with no ordering (initialization, private state)
+ */
+static inline void amp_atomic_store_relaxed(amp_atomic_u32_t *p, uint32_t value)
+{
+    AMP_ATOMIC_STORE(p, value, AMP_ATOMIC_RELAXED);
+}
+
+/**
+ * Store a word; earlier accesses complete before it (own index)
+ */
+static inline void amp_atomic_store_release(amp_atomic_u32_t *p, uint32_t value)
+{
+    AMP_ATOMIC_STORE(p, value, AMP_ATOMIC_RELEASE);
+}
+
+/**
+ * Add to a word, returning the old value
+ */
+static inline uint32_t amp_atomic_fetch_add(amp_atomic_u32_t *p, uint32_t value)
+{
+    return AMP_ATOMIC_FETCH_ADD(p, value, AMP_ATOMIC_ACQ_REL);
+}
+
+/**
+ * Subtract from a word, returning the old value
+ */
+static inline uint32_t amp_atomic_fetch_sub(amp_atomic_u32_t *p, uint32_t value)
+{
+    return AMP_ATOMIC_FETCH_SUB(p, value, AMP_ATOMIC_ACQ_REL);
+}
+
+/**
+ * OR into a word, returning the old value
+ */
+static inline uint32_t amp_atomic_fetch_or(amp_atomic_u32_t *p, uint32_t value)
+{
+    return AMP_ATOMIC_FETCH_OR(p, value, AMP_ATOMIC_ACQ_REL);
+}
+
+/**
+ * AND into a word, returning the old value
+ */
+static inline uint32_t amp_atomic_fetch_and(amp_atomic_u32_t *p, uint32_t value)
+{
+    return AMP_ATOMIC_FETCH_AND(p, value, AMP_ATOMIC_ACQ_REL);
+}
+
+/**
+ * Swap a word, returning the old value
+ */
+static inline uint32_t amp_atomic_exchange(amp_atomic_u32_t *p, uint32_t value)
+{
+    return AMP_ATOMIC_EXCHANGE(p, value, AMP_ATOMIC_ACQ_REL);
+}
+
+/**
+ * Replace a word if it still holds *expected
+ * On failure *expected is updated to the current value
+ */
+static inline bool amp_atomic_cas(amp_atomic_u32_t *p, uint32_t *expected, uint32_t desired)
+{
+    return AMP_ATOMIC_CAS(p, expected, desired, AMP_ATOMIC_ACQ_REL, AMP_ATOMIC_RELAXED);
+}
+
+/**
+ * Load a pointer with no ordering
+ */
+static inline void *amp_atomic_load_ptr_relaxed(const amp_atomic_ptr_t *p)
+{
+    return AMP_ATOMIC_LOAD(p, AMP_ATOMIC_RELAXED);
+}
+
+/**
+ * Load a pointer; accesses through it stay after the load
+ */
+static inline void *amp_atomic_load_ptr_acquire(const amp_atomic_ptr_t *p)
+{
+    return AMP_ATOMIC_LOAD(p, AMP_ATOMIC_ACQUIRE);
+}
+
+/**
+ * Store a pointer with no ordering (initialization)
+ */
+static inline void amp_atomic_store_ptr_relaxed(amp_atomic_ptr_t *p, void *value)
+{
+    AMP_ATOMIC_STORE(p, value, AMP_ATOMIC_RELAXED);
+}
+
+/**
+ * Store a pointer; the object it points to is initialized before it
+ */
+static inline void amp_atomic_store_ptr_release(amp_atomic_ptr_t *p, void *value)
+{
+    AMP_ATOMIC_STORE(p, value, AMP_ATOMIC_RELEASE);
+}
+
+/**
+ * Order earlier loads before later loads (re-checking a sequence number)
+ */
+static inline void amp_atomic_fence_acquire(void)
+{
+    AMP_ATOMIC_FENCE(AMP_ATOMIC_ACQUIRE);
+}
+
+/**
+ * Order earlier stores before later stores (publishing a new control block)
+ */
+static inline void amp_atomic_fence_release(void)
+{
+    AMP_ATOMIC_FENCE(AMP_ATOMIC_RELEASE);
+}
+
+/**
+ * Order earlier stores before later loads
+ * Each side of a sleep/wake handshake stores its own word, fences, then
+ * loads the other side's; with a fence on both sides at least one of them
+ * sees the other's store. MFENCE on x86, DMB on ARM
+ */
+static inline void amp_atomic_fence_seq_cst(void)
+{
+    AMP_ATOMIC_FENCE(AMP_ATOMIC_SEQ_CST);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMP_ATOMIC_H */
@@ -11,6 +11,7 @@
 
 #include <stdint.h>
 #include "amp_config.h"
+#include "amp_time.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -55,6 +56,15 @@ amp_boot_status_t amp_boot_core(amp_core_t core_id, uint32_t entry_point, uint32
  */
 amp_boot_status_t amp_boot_wait_core_ready(amp_core_t core_id, uint32_t timeout_ms);
 
+/**
+ * Wait for core to complete initialization until an absolute deadline
+ * 
+ * @param core_id Core to wait for
+ * @param deadline Absolute deadline (AMP_TIME_FOREVER = no timeout)
+ * @return AMP_BOOT_SUCCESS on success, error code on failure
+ */
+amp_boot_status_t amp_boot_wait_core_ready_until(amp_core_t core_id, amp_time_t deadline);
+
 /**
  * Signal that current core has completed initialization
  */
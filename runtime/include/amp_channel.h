@@ -0,0 +1,223 @@
+/**
+ * @file amp_channel.h
+ * @brief Compile-Time Typed Inter-Core Channels
+ *
+ * AMP_DEFINE_CHANNEL(name, type, slots) generates a single-producer,
+ * single-consumer channel of fixed-size messages whose type and slot count
+ * are known at compile time. Its send and receive are static inline, so a
+ * small message is copied with a few register moves and the slot index is a
+ * mask instead of a runtime multiply. Blocking calls sleep on doorbells like
+ * amp_mailbox. Channels cannot join a poll set.
+ *
+ * Cores that only use the try_* calls can create the channel without
+ * doorbells, which drops the ring from every send and receive.
+ *
+ * Example:
+ * @code
+ * typedef struct { uint32_t cmd; uint32_t arg; } cmd_msg_t;
+ * AMP_DEFINE_CHANNEL(cmd_chan, cmd_msg_t, 16)
+ *
+ * cmd_chan_t *ch = cmd_chan_create();
+ * cmd_chan_send(ch, &msg, timeout_ms);     // Core 0
+ * cmd_chan_recv(ch, &msg, timeout_ms);     // Core 1
+ * @endcode
+ */
+
+#ifndef AMP_CHANNEL_H
+#define AMP_CHANNEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "amp_atomic.h"
+#include "amp_doorbell.h"
+#include "amp_layout.h"
+#include "amp_shmem.h"
+#include "amp_time.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* C11 keywords used by AMP_DEFINE_CHANNEL, spelled for the including language */
+#ifdef __cplusplus
+#define AMP_CHANNEL_STATIC_ASSERT(cond, msg) static_assert(cond, msg)
+#define AMP_CHANNEL_ALIGNOF(type) alignof(type)
+#else
+#define AMP_CHANNEL_STATIC_ASSERT(cond, msg) _Static_assert(cond, msg)
+#define AMP_CHANNEL_ALIGNOF(type) _Alignof(type)
+#endif
+
+/**
+ * Define a typed channel
+ *
+ * Generates, for a channel called name:
+ * - name_t: channel control block and slots in shared memory
+ * - name_t *name_create(void): allocate and initialize (NULL on failure)
+ * - name_t *name_create_polled(void): same without doorbells, for try_* only;
+ *   blocking calls on it return -1 instead of waiting
+ * - int name_try_send(name_t *, const type *): 0 on success, -1 if full
+ * - int name_try_recv(name_t *, type *): 0 on success, -1 if empty
+ * - int name_send(name_t *, const type *, uint32_t timeout_ms)
+ * - int name_recv(name_t *, type *, uint32_t timeout_ms)
+ * - int name_send_until(name_t *, const type *, amp_time_t deadline)
+ * - int name_recv_until(name_t *, type *, amp_time_t deadline)
+ *
+ * @param name Channel name, used as prefix for the generated type and functions
+ * @param type Message type (copied by assignment)
+ * @param slots Number of message slots (power of 2)
+ */
+#define AMP_DEFINE_CHANNEL(name, type, slots)                                   \
+    AMP_CHANNEL_STATIC_ASSERT((slots) > 0 && ((slots) & ((slots) - 1)) == 0,    \
+                              #name ": slot count must be a power of 2");       \
+                                                                                \
+    typedef struct {                                                            \
+        AMP_LAYOUT_LINE amp_atomic_u32_t write_idx;     /* Producer */          \
+        AMP_LAYOUT_LINE amp_atomic_u32_t read_idx;      /* Consumer */          \
+        AMP_LAYOUT_LINE amp_doorbell_t rx_bell;         /* Configuration */     \
+        amp_doorbell_t tx_bell;                                                 \
+        AMP_LAYOUT_LINE type data[slots];                                       \
+    } name##_t;                                                                 \
+                                                                                \
+    /* Blocking operation, see name##_send_cond() */                            \
+    typedef struct {                                                            \
+        name##_t *ch;                                                           \
+        type *msg;                                                              \
+    } name##_wait_t;                                                            \
+                                                                                \
+    static inline name##_t *name##_alloc(bool bells)                            \
+    {                                                                           \
+        size_t align = AMP_CHANNEL_ALIGNOF(name##_t) > AMP_LAYOUT_ALIGN ?       \
+                       AMP_CHANNEL_ALIGNOF(name##_t) : AMP_LAYOUT_ALIGN;        \
+        name##_t *ch = (name##_t *)amp_shmem_alloc_aligned(sizeof(name##_t),    \
+                                                           align);              \
+        if (!ch) {                                                              \
+            return NULL;                                                        \
+        }                                                                       \
+                                                                                \
+        amp_atomic_store_relaxed(&ch->write_idx, 0);                            \
+        amp_atomic_store_relaxed(&ch->read_idx, 0);                             \
+        ch->rx_bell = NULL;                                                     \
+        ch->tx_bell = NULL;                                                     \
+        if (bells) {                                                            \
+            ch->rx_bell = amp_doorbell_create();                                \
+            ch->tx_bell = amp_doorbell_create();                                \
+            if (!ch->rx_bell || !ch->tx_bell) {                                 \
+                return NULL;                                                    \
+            }                                                                   \
+        }                                                                       \
+                                                                                \
+        /* Initialization completes before the handle reaches another core */   \
+        amp_atomic_fence_release();                                             \
+                                                                                \
+        return ch;                                                              \
+    }                                                                           \
+                                                                                \
+    static inline name##_t *name##_create(void)                                 \
+    {                                                                           \
+        return name##_alloc(true);                                              \
+    }                                                                           \
+                                                                                \
+    static inline name##_t *name##_create_polled(void)                          \
+    {                                                                           \
+        return name##_alloc(false);                                             \
+    }                                                                           \
+                                                                                \
+    static inline int name##_try_send(name##_t *ch, const type *msg)            \
+    {                                                                           \
+        uint32_t write_idx = amp_atomic_load_relaxed(&ch->write_idx);           \
+                                                                                \
+        /* Acquire: the slot is not written before the consumer is done */      \
+        uint32_t read_idx = amp_atomic_load_acquire(&ch->read_idx);             \
+        if (write_idx - read_idx >= (uint32_t)(slots)) {                        \
+            return -1;                                                          \
+        }                                                                       \
+                                                                                \
+        ch->data[write_idx & ((uint32_t)(slots) - 1u)] = *msg;                  \
+                                                                                \
+        /* Release: the message is complete before the write index covers it */ \
+        amp_atomic_store_release(&ch->write_idx, write_idx + 1u);               \
+        if (ch->rx_bell) {                                                      \
+            amp_doorbell_ring(ch->rx_bell);                                     \
+        }                                                                       \
+                                                                                \
+        return 0;                                                               \
+    }                                                                           \
+                                                                                \
+    static inline int name##_try_recv(name##_t *ch, type *msg)                  \
+    {                                                                           \
+        uint32_t read_idx = amp_atomic_load_relaxed(&ch->read_idx);             \
+                                                                                \
+        /* Acquire: the slot is not read ahead of the write index */            \
+        if (read_idx == amp_atomic_load_acquire(&ch->write_idx)) {              \
+            return -1;                                                          \
+        }                                                                       \
+                                                                                \
+        *msg = ch->data[read_idx & ((uint32_t)(slots) - 1u)];                   \
+                                                                                \
+        /* Release: the message is read before its slot is handed back */       \
+        amp_atomic_store_release(&ch->read_idx, read_idx + 1u);                 \
+        if (ch->tx_bell) {                                                      \
+            amp_doorbell_ring(ch->tx_bell);                                     \
+        }                                                                       \
+                                                                                \
+        return 0;                                                               \
+    }                                                                           \
+                                                                                \
+    static inline bool name##_send_cond(void *arg)                              \
+    {                                                                           \
+        name##_wait_t *wait = (name##_wait_t *)arg;                             \
+                                                                                \
+        return name##_try_send(wait->ch, wait->msg) == 0;                       \
+    }                                                                           \
+                                                                                \
+    static inline bool name##_recv_cond(void *arg)                              \
+    {                                                                           \
+        name##_wait_t *wait = (name##_wait_t *)arg;                             \
+                                                                                \
+        return name##_try_recv(wait->ch, wait->msg) == 0;                       \
+    }                                                                           \
+                                                                                \
+    static inline int name##_send_until(name##_t *ch, const type *msg,          \
+                                        amp_time_t deadline)                    \
+    {                                                                           \
+        /* Fast path: no doorbell setup while there is room */                  \
+        if (name##_try_send(ch, msg) == 0) {                                    \
+            return 0;                                                           \
+        }                                                                       \
+                                                                                \
+        name##_wait_t wait = { ch, (type *)msg };                               \
+                                                                                \
+        return amp_doorbell_wait_for(ch->tx_bell, name##_send_cond, &wait,      \
+                                     deadline);                                 \
+    }                                                                           \
+                                                                                \
+    static inline int name##_recv_until(name##_t *ch, type *msg,                \
+                                        amp_time_t deadline)                    \
+    {                                                                           \
+        /* Fast path: no doorbell setup while a message is queued */            \
+        if (name##_try_recv(ch, msg) == 0) {                                    \
+            return 0;                                                           \
+        }                                                                       \
+                                                                                \
+        name##_wait_t wait = { ch, msg };                                       \
+                                                                                \
+        return amp_doorbell_wait_for(ch->rx_bell, name##_recv_cond, &wait,      \
+                                     deadline);                                 \
+    }                                                                           \
+                                                                                \
+    static inline int name##_send(name##_t *ch, const type *msg,                \
+                                  uint32_t timeout_ms)                          \
+    {                                                                           \
+        return name##_send_until(ch, msg, amp_time_deadline_ms(timeout_ms));    \
+    }                                                                           \
+                                                                                \
+    static inline int name##_recv(name##_t *ch, type *msg, uint32_t timeout_ms) \
+    {                                                                           \
+        return name##_recv_until(ch, msg, amp_time_deadline_ms(timeout_ms));    \
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMP_CHANNEL_H */
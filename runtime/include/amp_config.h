@@ -16,6 +16,14 @@
 extern "C" {
 #endif
 
+/**
+ * Cache line size used to keep fields written by different cores apart
+ * (see AMP_LAYOUT_PADDED)
+ */
+#ifndef AMP_CACHE_LINE_SIZE
+#define AMP_CACHE_LINE_SIZE 64
+#endif
+
 /**
  * Core domain identifiers
  */
@@ -0,0 +1,121 @@
+/**
+ * @file amp_doorbell.h
+ * @brief Inter-Core Doorbell Notification
+ *
+ * Lets a core sleep until another core publishes something, instead of
+ * polling shared memory. A waiter spins briefly on its condition, then
+ * registers itself and sleeps; a producer rings the doorbell after
+ * publishing, which costs one fence and one load while nobody waits.
+ * The sleep and wake primitives are weak symbols so platforms can plug in
+ * their own mechanism:
+ * - ARM Cortex-M: WFE / SEV (the RP2350 cores share the event signal)
+ * - Linux host: futex on the doorbell word (works across processes)
+ * - Other hosts: polling
+ */
+
+#ifndef AMP_DOORBELL_H
+#define AMP_DOORBELL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "amp_atomic.h"
+#include "amp_time.h"
+#include "amp_wait.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Condition checks before a waiter goes to sleep
+ */
+#ifndef AMP_DOORBELL_SPIN
+#define AMP_DOORBELL_SPIN 1000
+#endif
+
+/**
+ * Doorbell handle
+ */
+typedef struct amp_doorbell_s *amp_doorbell_t;
+
+/**
+ * Wait condition
+ * Called repeatedly by amp_doorbell_wait_for(); may perform the awaited
+ * operation itself (e.g. a non-blocking receive)
+ *
+ * @param arg Caller context
+ * @return true once the wait is satisfied
+ */
+typedef bool (*amp_doorbell_cond_t)(void *arg);
+
+/**
+ * Create a doorbell in shared memory
+ *
+ * @return Doorbell handle or NULL on failure
+ */
+amp_doorbell_t amp_doorbell_create(void);
+
+/**
+ * Destroy a doorbell
+ *
+ * @param db Doorbell handle
+ */
+void amp_doorbell_destroy(amp_doorbell_t db);
+
+/**
+ * Wake every core waiting on the doorbell
+ * Call after publishing the state the waiters check. Returns at once, with
+ * no fence, while the doorbell's policy is AMP_WAIT_SPIN, AMP_WAIT_BACKOFF
+ * or AMP_WAIT_YIELD, whose waiters never sleep
+ *
+ * @param db Doorbell handle
+ */
+void amp_doorbell_ring(amp_doorbell_t db);
+
+/**
+ * Set how waiters on the doorbell wait after the initial spin
+ * Ringers read the policy too, so set it before any core waits on or rings
+ * the doorbell; a ring that still sees a polling policy does not wake a
+ * waiter that already sleeps
+ *
+ * @param db Doorbell handle
+ * @param policy Wait policy (AMP_WAIT_DEFAULT = global policy)
+ * @return 0 on success, -1 on error
+ */
+int amp_doorbell_set_policy(amp_doorbell_t db, amp_wait_policy_t policy);
+
+/**
+ * Wait until a condition holds, sleeping between rings
+ * Spins up to AMP_DOORBELL_SPIN checks, then waits as its policy says
+ *
+ * @param db Doorbell handle
+ * @param cond Condition to wait for
+ * @param arg Context passed to cond
+ * @param deadline Absolute deadline (AMP_TIME_FOREVER = no timeout)
+ * @return 0 once cond returned true, -1 on timeout or error
+ */
+int amp_doorbell_wait_for(amp_doorbell_t db, amp_doorbell_cond_t cond, void *arg,
+                          amp_time_t deadline);
+
+/**
+ * Sleep while a word still holds a value (platform hook)
+ * May return early; callers re-check their condition
+ *
+ * @param word Doorbell word
+ * @param value Value seen before deciding to sleep
+ * @param deadline Absolute deadline (AMP_TIME_FOREVER = no timeout)
+ */
+void amp_doorbell_sleep(amp_atomic_u32_t *word, uint32_t value, amp_time_t deadline);
+
+/**
+ * Wake every core sleeping on a word (platform hook)
+ *
+ * @param word Doorbell word
+ */
+void amp_doorbell_wake(amp_atomic_u32_t *word);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMP_DOORBELL_H */
@@ -0,0 +1,134 @@
+/**
+ * @file amp_event_group.h
+ * @brief Inter-Core Event Groups
+ *
+ * An event group is a 32-bit word of condition flags in shared memory. One
+ * core signals any number of conditions with a single atomic OR, and a
+ * waiter blocks until any or all of the bits it cares about are set,
+ * optionally clearing them as it returns. It replaces one semaphore per
+ * condition when a core only needs to know which conditions hold.
+ */
+
+#ifndef AMP_EVENT_GROUP_H
+#define AMP_EVENT_GROUP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "amp_time.h"
+#include "amp_wait.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Event group handle
+ */
+typedef struct amp_event_group_s *amp_event_group_t;
+
+/**
+ * Condition a waiter blocks on
+ */
+typedef enum {
+    AMP_EVENT_WAIT_ANY = 0,     /**< At least one bit of the mask is set */
+    AMP_EVENT_WAIT_ALL = 1      /**< Every bit of the mask is set */
+} amp_event_wait_t;
+
+/**
+ * Create an event group
+ *
+ * @param initial_bits Bits set at creation
+ * @return Event group handle or NULL on failure
+ */
+amp_event_group_t amp_event_group_create(uint32_t initial_bits);
+
+/**
+ * Destroy an event group
+ *
+ * @param group Event group handle
+ */
+void amp_event_group_destroy(amp_event_group_t group);
+
+/**
+ * Set how blocking calls on the event group wait after their initial spin
+ *
+ * @param group Event group handle
+ * @param policy Wait policy (AMP_WAIT_DEFAULT = global policy)
+ * @return 0 on success, -1 on error
+ */
+int amp_event_group_set_wait_policy(amp_event_group_t group, amp_wait_policy_t policy);
+
+/**
+ * Set bits and wake the waiters
+ * Accesses before the call are visible to a waiter that sees the bits
+ *
+ * @param group Event group handle
+ * @param bits Bits to set
+ * @return Bits before the call, 0 on error
+ */
+uint32_t amp_event_group_set_bits(amp_event_group_t group, uint32_t bits);
+
+/**
+ * Clear bits
+ *
+ * @param group Event group handle
+ * @param bits Bits to clear
+ * @return Bits before the call, 0 on error
+ */
+uint32_t amp_event_group_clear_bits(amp_event_group_t group, uint32_t bits);
+
+/**
+ * Get the bits currently set
+ *
+ * @param group Event group handle
+ * @return Current bits, 0 on error
+ */
+uint32_t amp_event_group_get_bits(amp_event_group_t group);
+
+/**
+ * Wait for bits (blocking)
+ * With clear_on_exit the bits of mask are cleared in the same atomic step
+ * that satisfies the wait, so among several waiters only one consumes them
+ *
+ * @param group Event group handle
+ * @param mask Bits to wait for (non-zero)
+ * @param mode Wait for any or for all bits of mask
+ * @param clear_on_exit Clear the bits of mask before returning
+ * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+ * @return Bits when the wait was satisfied (before clearing), 0 on timeout or error
+ */
+uint32_t amp_event_group_wait_bits(amp_event_group_t group, uint32_t mask,
+                                   amp_event_wait_t mode, bool clear_on_exit,
+                                   uint32_t timeout_ms);
+
+/**
+ * Wait for bits (blocking until an absolute deadline)
+ *
+ * @param group Event group handle
+ * @param mask Bits to wait for (non-zero)
+ * @param mode Wait for any or for all bits of mask
+ * @param clear_on_exit Clear the bits of mask before returning
+ * @param deadline Absolute deadline (AMP_TIME_FOREVER = no timeout)
+ * @return Bits when the wait was satisfied (before clearing), 0 on timeout or error
+ */
+uint32_t amp_event_group_wait_bits_until(amp_event_group_t group, uint32_t mask,
+                                         amp_event_wait_t mode, bool clear_on_exit,
+                                         amp_time_t deadline);
+
+/**
+ * Check for bits (non-blocking)
+ *
+ * @param group Event group handle
+ * @param mask Bits to check (non-zero)
+ * @param mode Check for any or for all bits of mask
+ * @param clear_on_exit Clear the bits of mask if the check succeeds
+ * @return Bits if the check succeeded (before clearing), 0 otherwise
+ */
+uint32_t amp_event_group_try_wait_bits(amp_event_group_t group, uint32_t mask,
+                                       amp_event_wait_t mode, bool clear_on_exit);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMP_EVENT_GROUP_H */
@@ -0,0 +1,117 @@
+/**
+ * @file amp_latest.h
+ * @brief Latest-Value Channel (Triple Buffer)
+ *
+ * Passes the newest value of some state from one producer core to one
+ * consumer core. Three buffers live in shared memory: the producer fills
+ * its own, the consumer reads its own, and one atomic swap per publish and
+ * per read trades a buffer with the shared middle slot. Neither side ever
+ * waits and nothing queues: values the consumer did not read in time are
+ * overwritten, and a read always returns the newest complete value.
+ */
+
+#ifndef AMP_LATEST_H
+#define AMP_LATEST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Latest-value channel handle
+ */
+typedef struct amp_latest_s *amp_latest_t;
+
+/**
+ * Create a latest-value channel
+ *
+ * @param size Maximum value size in bytes
+ * @return Channel handle or NULL on failure
+ */
+amp_latest_t amp_latest_create(size_t size);
+
+/**
+ * Destroy a latest-value channel
+ *
+ * @param latest Channel handle
+ */
+void amp_latest_destroy(amp_latest_t latest);
+
+/**
+ * Publish a value (producer, wait-free)
+ * Replaces any value the consumer has not read yet
+ *
+ * @param latest Channel handle
+ * @param data Value to publish
+ * @param len Value length in bytes
+ * @return 0 on success, -1 on error
+ */
+int amp_latest_publish(amp_latest_t latest, const void *data, uint32_t len);
+
+/**
+ * Read the newest value (consumer, wait-free)
+ *
+ * @param latest Channel handle
+ * @param data Buffer to copy the value into
+ * @param max_len Buffer size in bytes
+ * @param len Value length in bytes (output, may be NULL)
+ * @return 1 if the value is new since the last read, 0 if it was read
+ *         before, -1 if nothing was published yet or on error. A value
+ *         larger than max_len is kept: the next read still reports it new
+ */
+int amp_latest_read(amp_latest_t latest, void *data, uint32_t max_len, uint32_t *len);
+
+/**
+ * Check whether a value newer than the last read is available
+ *
+ * @param latest Channel handle
+ * @return true if amp_latest_read() would return a new value
+ */
+bool amp_latest_has_new(amp_latest_t latest);
+
+/**
+ * Get the producer's buffer for building a value in place (zero-copy)
+ * The buffer holds amp_latest_size() bytes and is published with
+ * amp_latest_commit_tx()
+ *
+ * @param latest Channel handle
+ * @return Pointer to the buffer or NULL on error
+ */
+void *amp_latest_acquire_tx_buffer(amp_latest_t latest);
+
+/**
+ * Publish the value built in the producer's buffer
+ *
+ * @param latest Channel handle
+ * @param len Value length in bytes
+ * @return 0 on success, -1 on error
+ */
+int amp_latest_commit_tx(amp_latest_t latest, uint32_t len);
+
+/**
+ * Access the newest value in place (zero-copy)
+ * The value stays valid until the consumer's next read or acquire
+ *
+ * @param latest Channel handle
+ * @param len Value length in bytes (output, may be NULL)
+ * @return Pointer to the value or NULL if nothing was published yet
+ */
+const void *amp_latest_acquire_rx_buffer(amp_latest_t latest, uint32_t *len);
+
+/**
+ * Get the maximum value size
+ *
+ * @param latest Channel handle
+ * @return Maximum value size in bytes
+ */
+size_t amp_latest_size(amp_latest_t latest);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMP_LATEST_H */
@@ -0,0 +1,35 @@
+/**
+ * @file amp_layout.h
+ * @brief Shared Control Block Layout
+ * 
+ * Layout helpers for control blocks that live in shared memory. With
+ * AMP_LAYOUT_PADDED, producer-owned fields, consumer-owned fields and
+ * immutable configuration are placed on separate cache lines so that an
+ * index update by one core does not invalidate the line the other core is
+ * polling (false sharing). Without it, control blocks stay compact.
+ */
+
+#ifndef AMP_LAYOUT_H
+#define AMP_LAYOUT_H
+
+#include "amp_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(AMP_LAYOUT_PADDED)
+    /* Start a new cache line */
+    #define AMP_LAYOUT_LINE __attribute__((aligned(AMP_CACHE_LINE_SIZE)))
+    /* Alignment of control block allocations */
+    #define AMP_LAYOUT_ALIGN AMP_CACHE_LINE_SIZE
+#else
+    #define AMP_LAYOUT_LINE
+    #define AMP_LAYOUT_ALIGN 8
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMP_LAYOUT_H */
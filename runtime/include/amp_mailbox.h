@@ -10,8 +10,11 @@
 #define AMP_MAILBOX_H
 
 #include <stdint.h>
+#include <stddef.h>
 #include <stdbool.h>
 #include "amp_config.h"
+#include "amp_time.h"
+#include "amp_wait.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,14 +25,44 @@ extern "C" {
  */
 typedef struct amp_mailbox_s *amp_mailbox_t;
 
+/**
+ * Maximum number of lanes in a priority mailbox
+ */
+#define AMP_MAILBOX_MAX_LANES 8
+
+/**
+ * Mailbox slot protocol
+ */
+typedef enum {
+    AMP_MAILBOX_MODE_INDEXED = 0,   /**< Shared read/write indices (default) */
+    AMP_MAILBOX_MODE_SEQUENCED = 1, /**< Per-slot sequence words: each side only
+                                         touches its own index and the slot it uses */
+    AMP_MAILBOX_MODE_MPSC = 2,      /**< Sequenced slots claimed with compare-and-swap:
+                                         any number of concurrent senders, one receiver */
+    AMP_MAILBOX_MODE_VARIABLE = 3   /**< Length-prefixed records packed into a byte arena;
+                                         msg_size is the largest message */
+} amp_mailbox_mode_t;
+
 /**
  * Mailbox configuration
  */
 typedef struct {
-    uint32_t msg_size;      /**< Size of each message in bytes */
-    uint32_t msg_slots;     /**< Number of message slots */
+    uint32_t msg_size;          /**< Size of each message in bytes */
+    uint32_t msg_slots;         /**< Number of message slots */
+    amp_mailbox_mode_t mode;    /**< Slot protocol */
+    uint32_t arena_size;        /**< Variable mode arena in bytes, rounded up to a power
+                                     of 2 and at least two largest records
+                                     (0 = room for msg_slots largest records) */
 } amp_mailbox_config_t;
 
+/**
+ * Priority lane statistics
+ */
+typedef struct {
+    uint32_t depth;     /**< Messages currently queued in the lane */
+    uint32_t drops;     /**< Sends that gave up because the lane was full */
+} amp_mailbox_lane_stats_t;
+
 /**
  * Create a mailbox
  * 
@@ -38,6 +71,19 @@ typedef struct {
  */
 amp_mailbox_t amp_mailbox_create(const amp_mailbox_config_t *config);
 
+/**
+ * Create a mailbox with priority lanes
+ * All lanes share one shared memory block and use config for their slots.
+ * Receives return the oldest message of the highest-numbered non-empty lane;
+ * plain sends go to lane 0. Batch and slot lease calls are not supported,
+ * nor is variable mode.
+ *
+ * @param config Per-lane configuration
+ * @param lanes Number of lanes (1 to AMP_MAILBOX_MAX_LANES)
+ * @return Mailbox handle or NULL on failure
+ */
+amp_mailbox_t amp_mailbox_create_priority(const amp_mailbox_config_t *config, uint32_t lanes);
+
 /**
  * Destroy a mailbox
  * 
@@ -45,6 +91,15 @@ amp_mailbox_t amp_mailbox_create(const amp_mailbox_config_t *config);
  */
 void amp_mailbox_destroy(amp_mailbox_t mbox);
 
+/**
+ * Set how blocking calls on the mailbox wait after their initial spin
+ *
+ * @param mbox Mailbox handle
+ * @param policy Wait policy (AMP_WAIT_DEFAULT = global policy)
+ * @return 0 on success, -1 on error
+ */
+int amp_mailbox_set_wait_policy(amp_mailbox_t mbox, amp_wait_policy_t policy);
+
 /**
  * Send a message (blocking)
  * 
@@ -65,6 +120,26 @@ int amp_mailbox_send(amp_mailbox_t mbox, const void *msg, uint32_t timeout_ms);
  */
 int amp_mailbox_recv(amp_mailbox_t mbox, void *msg, uint32_t timeout_ms);
 
+/**
+ * Send a message (blocking until an absolute deadline)
+ * 
+ * @param mbox Mailbox handle
+ * @param msg Message data
+ * @param deadline Absolute deadline (AMP_TIME_FOREVER = no timeout)
+ * @return 0 on success, negative on error
+ */
+int amp_mailbox_send_until(amp_mailbox_t mbox, const void *msg, amp_time_t deadline);
+
+/**
+ * Receive a message (blocking until an absolute deadline)
+ * 
+ * @param mbox Mailbox handle
+ * @param msg Buffer to receive message
+ * @param deadline Absolute deadline (AMP_TIME_FOREVER = no timeout)
+ * @return 0 on success, negative on error
+ */
+int amp_mailbox_recv_until(amp_mailbox_t mbox, void *msg, amp_time_t deadline);
+
 /**
  * Try to send a message (non-blocking)
  * 
@@ -83,6 +158,234 @@ int amp_mailbox_try_send(amp_mailbox_t mbox, const void *msg);
  */
 int amp_mailbox_try_recv(amp_mailbox_t mbox, void *msg);
 
+/**
+ * Send a variable-length message (blocking)
+ * Only len bytes (plus a 4-byte length header) are copied into the arena.
+ * Variable mode mailboxes only; plain send() carries msg_size bytes.
+ *
+ * @param mbox Variable mode mailbox handle
+ * @param msg Message data
+ * @param len Message length in bytes (at most msg_size)
+ * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+ * @return 0 on success, negative on error
+ */
+int amp_mailbox_send_var(amp_mailbox_t mbox, const void *msg, uint32_t len,
+                         uint32_t timeout_ms);
+
+/**
+ * Receive a variable-length message (blocking)
+ *
+ * @param mbox Variable mode mailbox handle
+ * @param msg Buffer to receive message
+ * @param max_len Size of the buffer (at least msg_size)
+ * @param len Filled with the message length
+ * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+ * @return 0 on success, negative on error
+ */
+int amp_mailbox_recv_var(amp_mailbox_t mbox, void *msg, uint32_t max_len, uint32_t *len,
+                         uint32_t timeout_ms);
+
+/**
+ * Send a variable-length message (blocking until an absolute deadline)
+ *
+ * @param mbox Variable mode mailbox handle
+ * @param msg Message data
+ * @param len Message length in bytes (at most msg_size)
+ * @param deadline Absolute deadline (AMP_TIME_FOREVER = no timeout)
+ * @return 0 on success, negative on error
+ */
+int amp_mailbox_send_var_until(amp_mailbox_t mbox, const void *msg, uint32_t len,
+                               amp_time_t deadline);
+
+/**
+ * Receive a variable-length message (blocking until an absolute deadline)
+ *
+ * @param mbox Variable mode mailbox handle
+ * @param msg Buffer to receive message
+ * @param max_len Size of the buffer (at least msg_size)
+ * @param len Filled with the message length
+ * @param deadline Absolute deadline (AMP_TIME_FOREVER = no timeout)
+ * @return 0 on success, negative on error
+ */
+int amp_mailbox_recv_var_until(amp_mailbox_t mbox, void *msg, uint32_t max_len, uint32_t *len,
+                               amp_time_t deadline);
+
+/**
+ * Try to send a variable-length message (non-blocking)
+ *
+ * @param mbox Variable mode mailbox handle
+ * @param msg Message data
+ * @param len Message length in bytes (at most msg_size)
+ * @return 0 on success, -1 if the arena is full
+ */
+int amp_mailbox_try_send_var(amp_mailbox_t mbox, const void *msg, uint32_t len);
+
+/**
+ * Try to receive a variable-length message (non-blocking)
+ *
+ * @param mbox Variable mode mailbox handle
+ * @param msg Buffer to receive message
+ * @param max_len Size of the buffer (at least msg_size)
+ * @param len Filled with the message length
+ * @return 0 on success, -1 if empty
+ */
+int amp_mailbox_try_recv_var(amp_mailbox_t mbox, void *msg, uint32_t max_len, uint32_t *len);
+
+/**
+ * Send a message to a priority lane (blocking)
+ *
+ * @param mbox Priority mailbox handle
+ * @param msg Message data
+ * @param lane Lane index (higher is more urgent)
+ * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+ * @return 0 on success, negative on error
+ */
+int amp_mailbox_send_priority(amp_mailbox_t mbox, const void *msg, uint32_t lane,
+                              uint32_t timeout_ms);
+
+/**
+ * Send a message to a priority lane (blocking until an absolute deadline)
+ *
+ * @param mbox Priority mailbox handle
+ * @param msg Message data
+ * @param lane Lane index (higher is more urgent)
+ * @param deadline Absolute deadline (AMP_TIME_FOREVER = no timeout)
+ * @return 0 on success, negative on error
+ */
+int amp_mailbox_send_priority_until(amp_mailbox_t mbox, const void *msg, uint32_t lane,
+                                    amp_time_t deadline);
+
+/**
+ * Try to send a message to a priority lane (non-blocking)
+ *
+ * @param mbox Priority mailbox handle
+ * @param msg Message data
+ * @param lane Lane index (higher is more urgent)
+ * @return 0 on success, -1 if the lane is full
+ */
+int amp_mailbox_try_send_priority(amp_mailbox_t mbox, const void *msg, uint32_t lane);
+
+/**
+ * Get the statistics of a priority lane
+ *
+ * @param mbox Priority mailbox handle
+ * @param lane Lane index
+ * @param stats Filled with the lane's depth and drop count
+ * @return 0 on success, -1 on error
+ */
+int amp_mailbox_get_lane_stats(amp_mailbox_t mbox, uint32_t lane,
+                               amp_mailbox_lane_stats_t *stats);
+
+/**
+ * Send several messages (blocking)
+ * Messages are copied slot by slot and published with a single barrier and
+ * index update per batch of free slots. Not available in variable mode.
+ *
+ * @param mbox Mailbox handle
+ * @param msgs Array of n messages, msg_size bytes each
+ * @param n Number of messages to send
+ * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+ * @return Number of messages sent (less than n on timeout)
+ */
+size_t amp_mailbox_send_batch(amp_mailbox_t mbox, const void *msgs, size_t n,
+                              uint32_t timeout_ms);
+
+/**
+ * Receive several messages (blocking)
+ * Waits for at least one message, then takes every queued message up to max
+ *
+ * @param mbox Mailbox handle
+ * @param msgs Buffer for up to max messages, msg_size bytes each
+ * @param max Maximum number of messages to receive
+ * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+ * @return Number of messages received (0 on timeout)
+ */
+size_t amp_mailbox_recv_batch(amp_mailbox_t mbox, void *msgs, size_t max,
+                              uint32_t timeout_ms);
+
+/**
+ * Send several messages (blocking until an absolute deadline)
+ *
+ * @param mbox Mailbox handle
+ * @param msgs Array of n messages, msg_size bytes each
+ * @param n Number of messages to send
+ * @param deadline Absolute deadline (AMP_TIME_FOREVER = no timeout)
+ * @return Number of messages sent (less than n on timeout)
+ */
+size_t amp_mailbox_send_batch_until(amp_mailbox_t mbox, const void *msgs, size_t n,
+                                    amp_time_t deadline);
+
+/**
+ * Receive several messages (blocking until an absolute deadline)
+ *
+ * @param mbox Mailbox handle
+ * @param msgs Buffer for up to max messages, msg_size bytes each
+ * @param max Maximum number of messages to receive
+ * @param deadline Absolute deadline (AMP_TIME_FOREVER = no timeout)
+ * @return Number of messages received (0 on timeout)
+ */
+size_t amp_mailbox_recv_batch_until(amp_mailbox_t mbox, void *msgs, size_t max,
+                                    amp_time_t deadline);
+
+/**
+ * Try to send several messages (non-blocking)
+ *
+ * @param mbox Mailbox handle
+ * @param msgs Array of n messages, msg_size bytes each
+ * @param n Number of messages to send
+ * @return Number of messages sent (limited by free slots)
+ */
+size_t amp_mailbox_try_send_batch(amp_mailbox_t mbox, const void *msgs, size_t n);
+
+/**
+ * Try to receive several messages (non-blocking)
+ *
+ * @param mbox Mailbox handle
+ * @param msgs Buffer for up to max messages, msg_size bytes each
+ * @param max Maximum number of messages to receive
+ * @return Number of messages received (limited by queued messages)
+ */
+size_t amp_mailbox_try_recv_batch(amp_mailbox_t mbox, void *msgs, size_t max);
+
+/**
+ * Lease the next free slot for building a message in place (non-blocking)
+ * The slot is 8-byte aligned in sequenced mode; in indexed mode its
+ * alignment follows msg_size. Only one transmit lease may be outstanding,
+ * so multi-producer mailboxes do not support transmit leases. Leases are
+ * not available in variable mode.
+ *
+ * @param mbox Mailbox handle
+ * @return Pointer to msg_size bytes of slot storage, or NULL if full or unsupported
+ */
+void *amp_mailbox_acquire_tx_slot(amp_mailbox_t mbox);
+
+/**
+ * Publish the slot leased by amp_mailbox_acquire_tx_slot()
+ * Must follow a successful acquire; the lease itself is not tracked
+ *
+ * @param mbox Mailbox handle
+ * @return 0 on success, -1 if the mailbox has no free slot to publish
+ */
+int amp_mailbox_commit_tx(amp_mailbox_t mbox);
+
+/**
+ * Lease the oldest queued message for reading in place (non-blocking)
+ * Only one receive lease may be outstanding.
+ *
+ * @param mbox Mailbox handle
+ * @return Pointer to the message in slot storage, or NULL if empty
+ */
+const void *amp_mailbox_acquire_rx_slot(amp_mailbox_t mbox);
+
+/**
+ * Return the slot leased by amp_mailbox_acquire_rx_slot() to the producer
+ * Must follow a successful acquire; the lease itself is not tracked
+ *
+ * @param mbox Mailbox handle
+ * @return 0 on success, -1 if the mailbox has no message to release
+ */
+int amp_mailbox_release_rx(amp_mailbox_t mbox);
+
 #ifdef __cplusplus
 }
 #endif
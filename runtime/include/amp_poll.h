@@ -0,0 +1,97 @@
+/**
+ * @file amp_poll.h
+ * @brief Readiness Polling Across IPC Objects
+ *
+ * Waits on any mix of mailboxes, ring buffers and semaphores at once. Each
+ * object in a poll set is linked to one bit of a readiness word in shared
+ * memory; producers set the bit and ring the set's doorbell after
+ * publishing, so an idle poll reads one word instead of every object.
+ */
+
+#ifndef AMP_POLL_H
+#define AMP_POLL_H
+
+#include <stdint.h>
+#include "amp_time.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Maximum number of objects in a poll set
+ */
+#define AMP_POLL_MAX_ITEMS 32
+
+/**
+ * Poll set handle
+ */
+typedef struct amp_poll_set_s *amp_poll_set_t;
+
+/**
+ * Type of a polled object
+ */
+typedef enum {
+    AMP_POLL_MAILBOX = 0,   /**< Ready while a message can be received */
+    AMP_POLL_RINGBUF = 1,   /**< Ready while data can be read */
+    AMP_POLL_SEMAPHORE = 2  /**< Ready while the count is non-zero */
+} amp_poll_type_t;
+
+/**
+ * Polled object
+ */
+typedef struct {
+    amp_poll_type_t type;   /**< Object type */
+    void *handle;           /**< amp_mailbox_t, amp_ringbuf_t or amp_semaphore_t */
+} amp_poll_item_t;
+
+/**
+ * Create a poll set
+ * Item i is reported as bit i of the ready mask. An object can belong to
+ * only one poll set at a time.
+ *
+ * @param items Objects to poll
+ * @param n Number of items (1 to AMP_POLL_MAX_ITEMS)
+ * @return Poll set handle or NULL on failure
+ */
+amp_poll_set_t amp_poll_set_create(const amp_poll_item_t *items, uint32_t n);
+
+/**
+ * Destroy a poll set
+ * Unlinks its objects so they can join another set
+ *
+ * @param set Poll set handle
+ */
+void amp_poll_set_destroy(amp_poll_set_t set);
+
+/**
+ * Wait until at least one object is ready (blocking)
+ *
+ * @param set Poll set handle
+ * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+ * @return Mask of ready items, 0 on timeout or error
+ */
+uint32_t amp_poll(amp_poll_set_t set, uint32_t timeout_ms);
+
+/**
+ * Wait until at least one object is ready (blocking until an absolute deadline)
+ *
+ * @param set Poll set handle
+ * @param deadline Absolute deadline (AMP_TIME_FOREVER = no timeout)
+ * @return Mask of ready items, 0 on timeout or error
+ */
+uint32_t amp_poll_until(amp_poll_set_t set, amp_time_t deadline);
+
+/**
+ * Check which objects are ready (non-blocking)
+ *
+ * @param set Poll set handle
+ * @return Mask of ready items, 0 if none
+ */
+uint32_t amp_poll_try(amp_poll_set_t set);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMP_POLL_H */
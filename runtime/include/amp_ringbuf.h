@@ -12,6 +12,8 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include "amp_time.h"
+#include "amp_wait.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,6 +24,14 @@ extern "C" {
  */
 typedef struct amp_ringbuf_s *amp_ringbuf_t;
 
+/**
+ * Contiguous region inside the ring buffer storage
+ */
+typedef struct {
+    void *data;     /**< Start of the region (NULL if empty) */
+    size_t len;     /**< Length in bytes */
+} amp_ringbuf_span_t;
+
 /**
  * Create a ring buffer
  * 
@@ -37,6 +47,15 @@ amp_ringbuf_t amp_ringbuf_create(size_t size);
  */
 void amp_ringbuf_destroy(amp_ringbuf_t rb);
 
+/**
+ * Set how blocking calls on the ring buffer wait after their initial spin
+ *
+ * @param rb Ring buffer handle
+ * @param policy Wait policy (AMP_WAIT_DEFAULT = global policy)
+ * @return 0 on success, -1 on error
+ */
+int amp_ringbuf_set_wait_policy(amp_ringbuf_t rb, amp_wait_policy_t policy);
+
 /**
  * Write data to ring buffer
  * 
@@ -57,6 +76,57 @@ size_t amp_ringbuf_write(amp_ringbuf_t rb, const void *data, size_t len);
  */
 size_t amp_ringbuf_read(amp_ringbuf_t rb, void *data, size_t len);
 
+/**
+ * Reserve space for writing in place (zero-copy)
+ * 
+ * Returns up to two spans inside the buffer storage: span1 runs to the end
+ * of the storage and span2 holds the wrapped remainder (len 0 if none).
+ * The producer fills the spans and publishes them with
+ * amp_ringbuf_write_commit().
+ * 
+ * @param rb Ring buffer handle
+ * @param len Bytes to reserve
+ * @param span1 First span
+ * @param span2 Second span
+ * @return Number of bytes reserved (less than len if not enough space)
+ */
+size_t amp_ringbuf_write_reserve(amp_ringbuf_t rb, size_t len,
+                                 amp_ringbuf_span_t *span1, amp_ringbuf_span_t *span2);
+
+/**
+ * Publish bytes written into reserved spans
+ * 
+ * @param rb Ring buffer handle
+ * @param len Bytes to publish (at most the reserved length)
+ * @return 0 on success, -1 if len exceeds the free space
+ */
+int amp_ringbuf_write_commit(amp_ringbuf_t rb, size_t len);
+
+/**
+ * Access readable data in place (zero-copy)
+ * 
+ * Returns up to two spans inside the buffer storage, as for
+ * amp_ringbuf_write_reserve(). The data stays in the buffer until the
+ * consumer calls amp_ringbuf_read_release().
+ * 
+ * @param rb Ring buffer handle
+ * @param len Maximum bytes to access
+ * @param span1 First span
+ * @param span2 Second span
+ * @return Number of bytes accessible
+ */
+size_t amp_ringbuf_read_peek(amp_ringbuf_t rb, size_t len,
+                             amp_ringbuf_span_t *span1, amp_ringbuf_span_t *span2);
+
+/**
+ * Release bytes consumed from peeked spans
+ * 
+ * @param rb Ring buffer handle
+ * @param len Bytes to release (at most the peeked length)
+ * @return 0 on success, -1 if len exceeds the available data
+ */
+int amp_ringbuf_read_release(amp_ringbuf_t rb, size_t len);
+
 /**
  * Get available bytes to read
  * 
@@ -75,11 +145,53 @@ size_t amp_ringbuf_free_space(amp_ringbuf_t rb);
 
 /**
  * Clear all data from buffer
+ * Consumer side: discards everything written so far
  * 
  * @param rb Ring buffer handle
  */
 void amp_ringbuf_clear(amp_ringbuf_t rb);
 
+/**
+ * Wait until at least len bytes can be read (blocking)
+ * Sleeps on the ring's doorbell instead of polling once a short spin passes
+ * 
+ * @param rb Ring buffer handle
+ * @param len Bytes needed (at most the buffer size)
+ * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+ * @return 0 when the data is available, negative on timeout or error
+ */
+int amp_ringbuf_wait_available(amp_ringbuf_t rb, size_t len, uint32_t timeout_ms);
+
+/**
+ * Wait until at least len bytes can be read (blocking until an absolute deadline)
+ * 
+ * @param rb Ring buffer handle
+ * @param len Bytes needed (at most the buffer size)
+ * @param deadline Absolute deadline (AMP_TIME_FOREVER = no timeout)
+ * @return 0 when the data is available, negative on timeout or error
+ */
+int amp_ringbuf_wait_available_until(amp_ringbuf_t rb, size_t len, amp_time_t deadline);
+
+/**
+ * Wait until at least len bytes can be written (blocking)
+ * 
+ * @param rb Ring buffer handle
+ * @param len Bytes needed (at most the buffer size)
+ * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+ * @return 0 when the space is free, negative on timeout or error
+ */
+int amp_ringbuf_wait_space(amp_ringbuf_t rb, size_t len, uint32_t timeout_ms);
+
+/**
+ * Wait until at least len bytes can be written (blocking until an absolute deadline)
+ * 
+ * @param rb Ring buffer handle
+ * @param len Bytes needed (at most the buffer size)
+ * @param deadline Absolute deadline (AMP_TIME_FOREVER = no timeout)
+ * @return 0 when the space is free, negative on timeout or error
+ */
+int amp_ringbuf_wait_space_until(amp_ringbuf_t rb, size_t len, amp_time_t deadline);
+
 #ifdef __cplusplus
 }
 #endif
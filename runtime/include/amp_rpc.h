@@ -0,0 +1,212 @@
+/**
+ * @file amp_rpc.h
+ * @brief Pipelined Inter-Core Remote Procedure Calls
+ *
+ * Request/response calls over a pair of variable mode mailboxes. Every
+ * request carries a correlation ID, so a client can keep up to a window of
+ * calls in flight and overlap their round trips. Completions are delivered
+ * to a callback or collected by ID. The server dispatches requests through
+ * a table of registered methods.
+ *
+ * An RPC channel has one client core and one server core; create a second
+ * channel for calls in the other direction.
+ */
+
+#ifndef AMP_RPC_H
+#define AMP_RPC_H
+
+#include <stdint.h>
+#include "amp_time.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Number of method IDs (0 to AMP_RPC_MAX_METHODS - 1)
+ */
+#define AMP_RPC_MAX_METHODS 16
+
+/**
+ * Maximum number of calls in flight
+ */
+#define AMP_RPC_MAX_WINDOW 64
+
+/**
+ * RPC handle
+ */
+typedef struct amp_rpc_s *amp_rpc_t;
+
+/**
+ * Call status
+ * Handlers may also return their own negative codes below AMP_RPC_TIMEOUT
+ */
+typedef enum {
+    AMP_RPC_OK = 0,             /**< Handler succeeded */
+    AMP_RPC_ERROR = -1,         /**< Handler failed or invalid call */
+    AMP_RPC_NO_METHOD = -2,     /**< No handler registered for the method */
+    AMP_RPC_TIMEOUT = -3        /**< No response before the timeout (client side) */
+} amp_rpc_status_t;
+
+/**
+ * RPC configuration
+ */
+typedef struct {
+    uint32_t max_payload;       /**< Largest request or response payload in bytes */
+    uint32_t window;            /**< Calls in flight (1 to AMP_RPC_MAX_WINDOW) */
+} amp_rpc_config_t;
+
+/**
+ * Method handler, runs on the server core
+ *
+ * @param ctx Context given at registration
+ * @param req Request payload
+ * @param req_len Request length in bytes
+ * @param resp Response buffer of max_payload bytes
+ * @param resp_len Response length in bytes (in: max_payload, out: length used)
+ * @return AMP_RPC_OK or a negative status, passed to the caller
+ */
+typedef int (*amp_rpc_handler_t)(void *ctx, const void *req, uint32_t req_len,
+                                 void *resp, uint32_t *resp_len);
+
+/**
+ * Completion callback, runs on the client core
+ * May start new asynchronous calls but must not wait on the same channel
+ *
+ * @param arg Argument given with the call
+ * @param status Call status
+ * @param resp Response payload, valid until the callback returns
+ * @param resp_len Response length in bytes
+ */
+typedef void (*amp_rpc_callback_t)(void *arg, int status, const void *resp,
+                                   uint32_t resp_len);
+
+/**
+ * Create an RPC channel
+ *
+ * @param config RPC configuration
+ * @return RPC handle or NULL on failure
+ */
+amp_rpc_t amp_rpc_create(const amp_rpc_config_t *config);
+
+/**
+ * Destroy an RPC channel
+ *
+ * @param rpc RPC handle
+ */
+void amp_rpc_destroy(amp_rpc_t rpc);
+
+/**
+ * Register a method handler (server core)
+ *
+ * @param rpc RPC handle
+ * @param method Method ID
+ * @param handler Handler function
+ * @param ctx Context passed to the handler
+ * @return 0 on success, -1 on error
+ */
+int amp_rpc_register(amp_rpc_t rpc, uint32_t method, amp_rpc_handler_t handler, void *ctx);
+
+/**
+ * Handle queued requests (server core, blocking)
+ * Waits for a request, then handles every request already queued
+ *
+ * @param rpc RPC handle
+ * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+ * @return Number of requests handled, 0 on timeout or error
+ */
+uint32_t amp_rpc_serve(amp_rpc_t rpc, uint32_t timeout_ms);
+
+/**
+ * Start a call completed through a callback (client core)
+ * Blocks only while the window is full, handling completions meanwhile.
+ * The callback runs from amp_rpc_poll() or any other blocking client call.
+ *
+ * @param rpc RPC handle
+ * @param method Method ID
+ * @param req Request payload
+ * @param req_len Request length in bytes (at most max_payload)
+ * @param callback Completion callback
+ * @param arg Argument passed to the callback
+ * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+ * @return 0 on success, -1 on error/timeout
+ */
+int amp_rpc_call_async(amp_rpc_t rpc, uint32_t method, const void *req, uint32_t req_len,
+                       amp_rpc_callback_t callback, void *arg, uint32_t timeout_ms);
+
+/**
+ * Start a call completed by ID (client core)
+ * The call holds its window slot until amp_rpc_call_finish() collects it
+ *
+ * @param rpc RPC handle
+ * @param method Method ID
+ * @param req Request payload
+ * @param req_len Request length in bytes (at most max_payload)
+ * @param id Receives the call ID
+ * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+ * @return 0 on success, -1 on error/timeout
+ */
+int amp_rpc_call_start(amp_rpc_t rpc, uint32_t method, const void *req, uint32_t req_len,
+                       uint32_t *id, uint32_t timeout_ms);
+
+/**
+ * Collect the response of a call started with amp_rpc_call_start() (client core)
+ * On timeout the call stays in flight and can be collected later
+ *
+ * @param rpc RPC handle
+ * @param id Call ID
+ * @param resp Response buffer
+ * @param max_len Size of the response buffer
+ * @param resp_len Receives the response length in bytes
+ * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+ * @return Call status
+ */
+int amp_rpc_call_finish(amp_rpc_t rpc, uint32_t id, void *resp, uint32_t max_len,
+                        uint32_t *resp_len, uint32_t timeout_ms);
+
+/**
+ * Call a method and wait for its response (client core)
+ *
+ * @param rpc RPC handle
+ * @param method Method ID
+ * @param req Request payload
+ * @param req_len Request length in bytes (at most max_payload)
+ * @param resp Response buffer
+ * @param max_len Size of the response buffer
+ * @param resp_len Receives the response length in bytes
+ * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+ * @return Call status
+ */
+int amp_rpc_call(amp_rpc_t rpc, uint32_t method, const void *req, uint32_t req_len,
+                 void *resp, uint32_t max_len, uint32_t *resp_len, uint32_t timeout_ms);
+
+/**
+ * Handle arrived responses (client core, non-blocking)
+ *
+ * @param rpc RPC handle
+ * @return Number of responses handled
+ */
+uint32_t amp_rpc_poll(amp_rpc_t rpc);
+
+/**
+ * Wait until every call in flight has its response (client core)
+ *
+ * @param rpc RPC handle
+ * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+ * @return 0 on success, -1 on error/timeout
+ */
+int amp_rpc_drain(amp_rpc_t rpc, uint32_t timeout_ms);
+
+/**
+ * Get the number of calls awaiting a response (client core)
+ *
+ * @param rpc RPC handle
+ * @return Calls in flight
+ */
+uint32_t amp_rpc_in_flight(amp_rpc_t rpc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMP_RPC_H */
@@ -10,6 +10,8 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "amp_time.h"
+#include "amp_wait.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,6 +38,15 @@ amp_semaphore_t amp_semaphore_create(uint32_t initial_count, uint32_t max_count)
  */
 void amp_semaphore_destroy(amp_semaphore_t sem);
 
+/**
+ * Set how blocking calls on the semaphore wait after their initial spin
+ *
+ * @param sem Semaphore handle
+ * @param policy Wait policy (AMP_WAIT_DEFAULT = global policy)
+ * @return 0 on success, -1 on error
+ */
+int amp_semaphore_set_wait_policy(amp_semaphore_t sem, amp_wait_policy_t policy);
+
 /**
  * Wait on semaphore (blocking)
  * 
@@ -47,6 +58,15 @@ void amp_semaphore_destroy(amp_semaphore_t sem);
  */
 int amp_semaphore_wait(amp_semaphore_t sem, uint32_t timeout_ms);
 
+/**
+ * Wait on semaphore (blocking until an absolute deadline)
+ * 
+ * @param sem Semaphore handle
+ * @param deadline Absolute deadline (AMP_TIME_FOREVER = no timeout)
+ * @return 0 on success, negative on error/timeout
+ */
+int amp_semaphore_wait_until(amp_semaphore_t sem, amp_time_t deadline);
+
 /**
  * Try to wait on semaphore (non-blocking)
  * 
@@ -0,0 +1,180 @@
+/**
+ * @file amp_seqlock.h
+ * @brief Sequence Lock for Shared State Snapshots
+ *
+ * Lets one core publish a block of state that other cores read without
+ * locking. The writer bumps a sequence number to an odd value before its
+ * update and back to an even value after it; a reader copies the state and
+ * retries if the sequence number was odd or changed meanwhile. Readers never
+ * write shared memory and the writer never waits for them.
+ *
+ * Only acquire and release ordering is needed, so on x86 neither side
+ * issues a fence instruction; ARM gets one DMB per side.
+ *
+ * The lock is a plain struct so it can sit next to the state it protects:
+ * @code
+ * typedef struct {
+ *     amp_seqlock_t lock;
+ *     control_state_t state;
+ * } shared_state_t;
+ *
+ * // Writer (one core only)
+ * amp_seqlock_write_begin(&shared->lock);
+ * shared->state.setpoint = setpoint;
+ * amp_seqlock_write_end(&shared->lock);
+ *
+ * // Reader
+ * control_state_t snapshot;
+ * uint32_t seq;
+ * do {
+ *     seq = amp_seqlock_read_begin(&shared->lock);
+ *     snapshot = shared->state;
+ * } while (amp_seqlock_read_retry(&shared->lock, seq));
+ * @endcode
+ */
+
+#ifndef AMP_SEQLOCK_H
+#define AMP_SEQLOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "amp_atomic.h"
+#include "amp_wait.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Retries before amp_seqlock_read() starts yielding, so a writer preempted
+ * mid-update on a host or RTOS can finish
+ */
+#ifndef AMP_SEQLOCK_SPIN
+#define AMP_SEQLOCK_SPIN 100
+#endif
+
+/**
+ * Sequence lock, placed in shared memory
+ */
+typedef struct {
+    amp_atomic_u32_t seq;   /**< Odd while an update is in progress */
+} amp_seqlock_t;
+
+/**
+ * Initialize a sequence lock
+ *
+ * @param lock Sequence lock
+ */
+static inline void amp_seqlock_init(amp_seqlock_t *lock)
+{
+    amp_atomic_store_relaxed(&lock->seq, 0);
+}
+
+/**
+ * Start an update (writer only)
+ *
+ * @param lock Sequence lock
+ */
+static inline void amp_seqlock_write_begin(amp_seqlock_t *lock)
+{
+    amp_atomic_store_relaxed(&lock->seq, amp_atomic_load_relaxed(&lock->seq) + 1u);
+
+    /* Release fence so readers see the odd sequence before any new data */
+    amp_atomic_fence_release();
+}
+
+/**
+ * Finish an update (writer only)
+ *
+ * @param lock Sequence lock
+ */
+static inline void amp_seqlock_write_end(amp_seqlock_t *lock)
+{
+    /* Release so the new data is visible before the even sequence */
+    amp_atomic_store_release(&lock->seq, amp_atomic_load_relaxed(&lock->seq) + 1u);
+}
+
+/**
+ * Start a read
+ * Never waits: during an update the returned value makes the read retry
+ *
+ * @param lock Sequence lock
+ * @return Sequence number to pass to amp_seqlock_read_retry()
+ */
+static inline uint32_t amp_seqlock_read_begin(const amp_seqlock_t *lock)
+{
+    /* Acquire so the data is not read ahead of the sequence */
+    uint32_t seq = amp_atomic_load_acquire(&lock->seq);
+
+    /* An odd (in-progress) sequence can never match on retry */
+    return seq & ~1u;
+}
+
+/**
+ * Check whether a read must be repeated
+ *
+ * @param lock Sequence lock
+ * @param seq Value returned by amp_seqlock_read_begin()
+ * @return true if an update overlapped the read
+ */
+static inline bool amp_seqlock_read_retry(const amp_seqlock_t *lock, uint32_t seq)
+{
+    /* Acquire fence so the data is read before the sequence is re-checked */
+    amp_atomic_fence_acquire();
+
+    return amp_atomic_load_relaxed(&lock->seq) != seq;
+}
+
+/**
+ * Publish a block of state (writer only)
+ *
+ * @param lock Sequence lock
+ * @param dst Shared state
+ * @param src New contents
+ * @param len Size in bytes
+ */
+static inline void amp_seqlock_write(amp_seqlock_t *lock, void *dst, const void *src,
+                                     size_t len)
+{
+    amp_seqlock_write_begin(lock);
+    memcpy(dst, src, len);
+    amp_seqlock_write_end(lock);
+}
+
+/**
+ * Take a consistent snapshot of a block of state
+ * Retries while updates overlap the copy
+ *
+ * @param lock Sequence lock
+ * @param dst Snapshot buffer
+ * @param src Shared state
+ * @param len Size in bytes
+ * @return Number of retries
+ */
+static inline uint32_t amp_seqlock_read(const amp_seqlock_t *lock, void *dst, const void *src,
+                                        size_t len)
+{
+    uint32_t retries = 0;
+
+    while (1) {
+        uint32_t seq = amp_seqlock_read_begin(lock);
+        memcpy(dst, src, len);
+        if (!amp_seqlock_read_retry(lock, seq)) {
+            return retries;
+        }
+
+        if (++retries < AMP_SEQLOCK_SPIN) {
+            amp_wait_relax();
+        } else {
+            amp_wait_yield();
+        }
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMP_SEQLOCK_H */
@@ -28,20 +28,48 @@ typedef struct {
 /**
  * Initialize shared memory subsystem
  * 
+ * With AMP_LAYOUT_PADDED the base should be cache line aligned.
+ * 
  * @param base Base address of shared memory pool
- * @param size Total size of shared memory pool
+ * @param size Total size of shared memory pool (below 4 GiB)
  * @return 0 on success, negative on error
  */
 int amp_shmem_init(void *base, size_t size);
 
+/**
+ * Attach to a shared memory pool initialized by another core
+ * 
+ * Used by cores that run as separate images: the pool and its allocator
+ * state are shared, nothing is cleared.
+ * 
+ * @param base Base address of the shared memory pool
+ * @param size Total size of shared memory pool
+ * @return 0 on success, negative if the pool is not initialized
+ */
+int amp_shmem_attach(void *base, size_t size);
+
 /**
  * Allocate a shared memory region
  * 
+ * Safe to call from any core.
+ * 
  * @param size Size to allocate in bytes
  * @return Pointer to allocated region or NULL on failure
  */
 void *amp_shmem_alloc(size_t size);
 
+/**
+ * Allocate an aligned shared memory region
+ * 
+ * The size is rounded up to a multiple of the alignment, so the region
+ * shares no alignment unit (e.g. cache line) with its neighbours.
+ * 
+ * @param size Size to allocate in bytes
+ * @param align Alignment in bytes (power of 2, at least 8)
+ * @return Pointer to allocated region or NULL on failure
+ */
+void *amp_shmem_alloc_aligned(size_t size, size_t align);
+
 /**
  * Free a shared memory region
  * 
@@ -58,6 +86,37 @@ void amp_shmem_free(void *ptr);
  */
 int amp_shmem_get_region(const void *ptr, amp_shmem_region_t *region);
 
+/**
+ * Publish the application's root object
+ *
+ * Cores running as separate images share no globals, so core 0 places the
+ * handles other cores need in one shared structure and publishes it here
+ * before booting them; they find it with amp_shmem_get_root() after
+ * amp_shmem_attach().
+ *
+ * @param root Object allocated from the pool (NULL clears the root)
+ * @return 0 on success, negative if root is outside the pool
+ */
+int amp_shmem_set_root(void *root);
+
+/**
+ * Get the application's root object
+ *
+ * @return Root object, or NULL if none was published
+ */
+void *amp_shmem_get_root(void);
+
+#if defined(AMP_PLATFORM_HOST)
+/**
+ * Get the host-allocated shared memory pool
+ * 
+ * Host simulation platforms back SHMEM_BASE with this allocation.
+ * 
+ * @return Base address of the simulated shared memory pool
+ */
+void *amp_host_shmem_base(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
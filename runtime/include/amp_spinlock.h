@@ -0,0 +1,86 @@
+/**
+ * @file amp_spinlock.h
+ * @brief Fair Inter-Core Spinlocks
+ *
+ * Mutual exclusion for short critical sections, granted in arrival order:
+ * - Ticket lock: one fetch-and-add to take a ticket, then waits reading the
+ *   ticket being served; the smallest lock and the cheapest handoff
+ * - MCS lock: each core queues its own node and waits on it, so waiters
+ *   poll separate cache lines and a release touches only the next waiter
+ *
+ * Waiters spin with CPU relax hints, then yield between checks so a holder
+ * preempted on a host or RTOS can run. Locks are not recursive.
+ */
+
+#ifndef AMP_SPINLOCK_H
+#define AMP_SPINLOCK_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Checks before a waiter starts yielding
+ */
+#ifndef AMP_SPINLOCK_SPIN
+#define AMP_SPINLOCK_SPIN 100
+#endif
+
+/**
+ * Spinlock handle
+ */
+typedef struct amp_spinlock_s *amp_spinlock_t;
+
+/**
+ * Spinlock algorithm
+ */
+typedef enum {
+    AMP_SPINLOCK_TICKET = 0,    /**< Ticket lock */
+    AMP_SPINLOCK_MCS = 1        /**< MCS queue lock, one node per core
+                                     (needs a platform amp_get_core_id()) */
+} amp_spinlock_type_t;
+
+/**
+ * Create a spinlock (unlocked)
+ *
+ * @param type Spinlock algorithm
+ * @return Spinlock handle or NULL on failure
+ */
+amp_spinlock_t amp_spinlock_create(amp_spinlock_type_t type);
+
+/**
+ * Destroy a spinlock
+ *
+ * @param lock Spinlock handle
+ */
+void amp_spinlock_destroy(amp_spinlock_t lock);
+
+/**
+ * Acquire a spinlock, waiting as long as it takes
+ *
+ * @param lock Spinlock handle
+ */
+void amp_spinlock_lock(amp_spinlock_t lock);
+
+/**
+ * Try to acquire a spinlock (non-blocking)
+ *
+ * @param lock Spinlock handle
+ * @return 0 on success, -1 if held or queued for
+ */
+int amp_spinlock_trylock(amp_spinlock_t lock);
+
+/**
+ * Release a spinlock held by this core
+ *
+ * @param lock Spinlock handle
+ */
+void amp_spinlock_unlock(amp_spinlock_t lock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMP_SPINLOCK_H */
@@ -0,0 +1,74 @@
+/**
+ * @file amp_time.h
+ * @brief Monotonic Time Base
+ *
+ * Provides a monotonic microsecond clock and a cycle counter used for
+ * timeouts and deadlines. The clock sources are weak symbols so platforms
+ * can plug in their own timer:
+ * - RP2350: 1MHz system TIMER0
+ * - Other ARM Cortex-M: DWT cycle counter scaled by AMP_TIME_CPU_HZ
+ * - Host: clock_gettime(CLOCK_MONOTONIC)
+ */
+
+#ifndef AMP_TIME_H
+#define AMP_TIME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Absolute time or deadline in microseconds since an arbitrary epoch
+ */
+typedef uint64_t amp_time_t;
+
+/**
+ * Deadline that never expires
+ */
+#define AMP_TIME_FOREVER UINT64_MAX
+
+/**
+ * Get the current monotonic time
+ *
+ * @return Time in microseconds
+ */
+amp_time_t amp_time_now_us(void);
+
+/**
+ * Get the current cycle counter
+ *
+ * @return Free-running cycle count (wraps), see amp_time_cycle_hz()
+ */
+uint32_t amp_time_cycles(void);
+
+/**
+ * Get the cycle counter frequency
+ *
+ * @return Cycles per second
+ */
+uint32_t amp_time_cycle_hz(void);
+
+/**
+ * Convert a relative timeout to an absolute deadline
+ *
+ * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+ * @return Deadline, or AMP_TIME_FOREVER if timeout_ms is 0
+ */
+amp_time_t amp_time_deadline_ms(uint32_t timeout_ms);
+
+/**
+ * Check whether a deadline has passed
+ *
+ * @param deadline Absolute deadline
+ * @return true if the deadline has passed
+ */
+bool amp_time_expired(amp_time_t deadline);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMP_TIME_H */
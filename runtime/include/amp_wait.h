@@ -0,0 +1,124 @@
+/**
+ * @file amp_wait.h
+ * @brief Wait Policies for Blocking Calls
+ *
+ * Selects how a blocked call waits once its short initial spin is over.
+ * Spinning gives the lowest wakeup latency but keeps the core and the
+ * shared bus busy; sleeping on the doorbell frees both at the price of a
+ * wakeup. Each mailbox, ring buffer and semaphore can override the global
+ * policy of the core image.
+ *
+ * amp_wait_on() / amp_wake() apply the same waiting to any 32-bit word in
+ * shared memory: a core parks until the word changes, and the core that
+ * changes it wakes the parked cores.
+ */
+
+#ifndef AMP_WAIT_H
+#define AMP_WAIT_H
+
+#include <stdint.h>
+#include "amp_atomic.h"
+#include "amp_time.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Longest backoff pause, in CPU relax hints
+ */
+#ifndef AMP_WAIT_BACKOFF_MAX
+#define AMP_WAIT_BACKOFF_MAX 1024
+#endif
+
+/**
+ * Wait policy
+ */
+typedef enum {
+    AMP_WAIT_DEFAULT = 0,   /**< Objects: follow the global policy */
+    AMP_WAIT_SPIN = 1,      /**< Re-check continuously */
+    AMP_WAIT_BACKOFF = 2,   /**< Spin, then re-check after pauses doubling up to
+                                 AMP_WAIT_BACKOFF_MAX relax hints */
+    AMP_WAIT_SLEEP = 3,     /**< Spin, then sleep on the doorbell (WFE / futex) */
+    AMP_WAIT_YIELD = 4      /**< Spin, then yield the CPU between checks */
+} amp_wait_policy_t;
+
+/**
+ * Set the global wait policy (AMP_WAIT_SLEEP by default)
+ * Applies to every object without a policy of its own, on this core image
+ *
+ * @param policy Wait policy (AMP_WAIT_DEFAULT restores AMP_WAIT_SLEEP)
+ */
+void amp_wait_set_default_policy(amp_wait_policy_t policy);
+
+/**
+ * Get the global wait policy
+ *
+ * @return Wait policy
+ */
+amp_wait_policy_t amp_wait_get_default_policy(void);
+
+/**
+ * Give the CPU to another thread or task (platform hook)
+ * sched_yield() on Linux hosts; a no-op elsewhere, for RTOS ports to override
+ */
+void amp_wait_yield(void);
+
+/**
+ * Wait until a word no longer holds a value (blocking)
+ * Spins AMP_DOORBELL_SPIN checks, then waits as the global policy says;
+ * AMP_WAIT_SLEEP parks the core (WFE on Cortex-M, futex on Linux hosts,
+ * polling elsewhere) until amp_wake() is called on the word
+ *
+ * The writer publishes the word with amp_atomic_store_release() or an
+ * amp_atomic RMW; the waiter's acquire load then makes everything written
+ * before it visible once this returns 0.
+ *
+ * @param addr Word in shared memory
+ * @param expected Value to wait out
+ * @param timeout_ms Timeout in milliseconds (0 = no timeout)
+ * @return 0 once the word differs from expected, -1 on timeout or error
+ */
+int amp_wait_on(amp_atomic_u32_t *addr, uint32_t expected, uint32_t timeout_ms);
+
+/**
+ * Wait until a word no longer holds a value (blocking until an absolute deadline)
+ *
+ * @param addr Word in shared memory
+ * @param expected Value to wait out
+ * @param deadline Absolute deadline (AMP_TIME_FOREVER = no timeout)
+ * @return 0 once the word differs from expected, -1 on timeout or error
+ */
+int amp_wait_on_until(amp_atomic_u32_t *addr, uint32_t expected, amp_time_t deadline);
+
+/**
+ * Wake every core waiting on a word
+ * Call after publishing the word with amp_atomic_store_release() or an
+ * amp_atomic RMW. Costs a wake call (SEV, futex syscall)
+ * even when nobody waits; objects that publish often should use a
+ * doorbell, which skips the wake while it has no waiters
+ *
+ * @param addr Word in shared memory
+ */
+void amp_wake(amp_atomic_u32_t *addr);
+
+/**
+ * Tell the CPU it is in a spin loop
+ * Cheaper than a yield: lets the other hardware thread run, or saves power
+ */
+static inline void amp_wait_relax(void)
+{
+#if defined(__ARM_ARCH) || defined(__arm__)
+    __asm__ volatile("yield" ::: "memory");
+#elif defined(__x86_64__) || defined(__i386__)
+    __asm__ volatile("pause" ::: "memory");
+#else
+    __asm__ volatile("" ::: "memory");
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMP_WAIT_H */
@@ -4,11 +4,45 @@
  */
 
 #include "amp_boot.h"
-#include "amp_barriers.h"
+#include "amp_atomic.h"
+#include "amp_doorbell_internal.h"
+#include "amp_shmem_internal.h"
 #include <string.h>
 
-/* Boot state tracking */
-static volatile uint32_t core_ready_flags = 0;
+/* Boot state tracking before the shared pool is initialized */
+static amp_atomic_u32_t local_ready_flags = 0;
+static struct amp_doorbell_s local_ready_bell;
+
+/**
+ * Get the core ready flags
+ * Kept in the shared pool so cores running as separate images agree
+ */
+static amp_atomic_u32_t *core_ready_flags(void)
+{
+    amp_atomic_u32_t *flags = amp_shmem_boot_flags();
+
+    return flags ? flags : &local_ready_flags;
+}
+
+/**
+ * Get the doorbell rung by amp_boot_signal_ready()
+ */
+static amp_doorbell_t core_ready_bell(void)
+{
+    amp_doorbell_t bell = amp_shmem_boot_bell();
+
+    return bell ? bell : &local_ready_bell;
+}
+
+/**
+ * Doorbell condition: every core in the mask is ready
+ */
+static bool core_ready_cond(void *arg)
+{
+    uint32_t mask = *(const uint32_t *)arg;
+
+    return (amp_atomic_load_acquire(core_ready_flags()) & mask) == mask;
+}
 
 /**
  * Initialize the AMP runtime
@@ -20,11 +54,8 @@ amp_boot_status_t amp_boot_init(void)
         return AMP_BOOT_ERROR_INVALID_CORE;
     }
 
-    /* Initialize ready flags */
-    core_ready_flags = 0;
-
-    /* Mark primary core as ready */
-    core_ready_flags |= (1 << AMP_CORE0);
+    /* Initialize ready flags and mark primary core as ready */
+    amp_atomic_store_release(core_ready_flags(), 1u << AMP_CORE0);
 
     return AMP_BOOT_SUCCESS;
 }
@@ -57,22 +88,23 @@ __attribute__((weak)) amp_boot_status_t amp_boot_core(amp_core_t core_id,
  * Wait for core to complete initialization
  */
 amp_boot_status_t amp_boot_wait_core_ready(amp_core_t core_id, uint32_t timeout_ms)
+{
+    return amp_boot_wait_core_ready_until(core_id, amp_time_deadline_ms(timeout_ms));
+}
+
+/**
+ * Wait for core to complete initialization until an absolute deadline
+ */
+amp_boot_status_t amp_boot_wait_core_ready_until(amp_core_t core_id, amp_time_t deadline)
 {
     if (core_id >= AMP_CORE_COUNT) {
         return AMP_BOOT_ERROR_INVALID_CORE;
     }
 
-    uint32_t mask = (1 << core_id);
-    
-    /* Simple busy-wait timeout implementation
-     * NOTE: This is inaccurate and platform-dependent (Phase 1 limitation)
-     * Production implementations should use hardware timers
-     */
-    uint32_t count = timeout_ms * 1000; /* Approximate */
-    while (!(core_ready_flags & mask)) {
-        if (timeout_ms > 0 && --count == 0) {
-            return AMP_BOOT_ERROR_TIMEOUT;
-        }
+    uint32_t mask = (1u << core_id);
+
+    if (amp_doorbell_wait_for(core_ready_bell(), core_ready_cond, &mask, deadline) != 0) {
+        return AMP_BOOT_ERROR_TIMEOUT;
     }
 
     return AMP_BOOT_SUCCESS;
@@ -84,8 +116,10 @@ amp_boot_status_t amp_boot_wait_core_ready(amp_core_t core_id, uint32_t timeout_
 void amp_boot_signal_ready(void)
 {
     amp_core_t core_id = amp_get_core_id();
-    core_ready_flags |= (1 << core_id);
-    
-    /* Memory barrier to ensure visibility */
-    AMP_DMB();
+
+    /* Atomic OR, several cores may signal at once. Release: everything the
+     * core set up is visible to a core that sees its flag
+     */
+    (void)amp_atomic_fetch_or(core_ready_flags(), 1u << core_id);
+    amp_doorbell_ring(core_ready_bell());
 }
@@ -0,0 +1,100 @@
+/**
+ * @file amp_copy.h
+ * @brief Bulk Copy Kernel for Shared Memory Transfers
+ *
+ * Copy routine used by the IPC primitives to move payload in and out of
+ * shared memory. The kernel is chosen at build time (AMP_COPY_KERNEL):
+ * - memcpy: C library memcpy (default; vectorized on hosts)
+ * - word:   32-bit word copy, for MCU C libraries whose memcpy
+ *           is optimized for size (e.g. newlib-nano copies bytes)
+ */
+
+#ifndef AMP_COPY_H
+#define AMP_COPY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(AMP_COPY_KERNEL_WORD)
+
+/* Word type allowed to alias the byte storage it is copied through */
+typedef uint32_t __attribute__((may_alias)) amp_copy_word_t;
+
+/**
+ * Load a word from a possibly unaligned address
+ * A single LDR on cores with hardware unaligned access (ARMv7-M and later)
+ */
+static inline uint32_t amp_copy_load(const char *s)
+{
+    uint32_t w;
+    __builtin_memcpy(&w, s, sizeof(w));
+    return w;
+}
+
+/**
+ * Copy len bytes using word transfers to an aligned destination
+ */
+static inline void amp_copy(void *dst, const void *src, size_t len)
+{
+    char *d = (char *)dst;
+    const char *s = (const char *)src;
+
+    while (len > 0 && ((uintptr_t)d & 3u) != 0) {
+        *d++ = *s++;
+        len--;
+    }
+
+    amp_copy_word_t *dw = (amp_copy_word_t *)d;
+
+    /* 16 bytes per iteration keeps four loads in flight */
+    while (len >= 16) {
+        uint32_t w0 = amp_copy_load(s);
+        uint32_t w1 = amp_copy_load(s + 4);
+        uint32_t w2 = amp_copy_load(s + 8);
+        uint32_t w3 = amp_copy_load(s + 12);
+        dw[0] = w0;
+        dw[1] = w1;
+        dw[2] = w2;
+        dw[3] = w3;
+        dw += 4;
+        s += 16;
+        len -= 16;
+    }
+
+    while (len >= 4) {
+        *dw++ = amp_copy_load(s);
+        s += 4;
+        len -= 4;
+    }
+
+    d = (char *)dw;
+    while (len > 0) {
+        *d++ = *s++;
+        len--;
+    }
+}
+
+#else
+
+/**
+ * Copy len bytes with the C library memcpy
+ */
+static inline void amp_copy(void *dst, const void *src, size_t len)
+{
+    if (len > 0) {
+        memcpy(dst, src, len);
+    }
+}
+
+#endif /* AMP_COPY_KERNEL_WORD */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMP_COPY_H */
@@ -0,0 +1,264 @@
+/**
+ * @file amp_doorbell.c
+ * @brief Inter-Core Doorbell Implementation
+ */
+
+#if defined(__linux__)
+#define _GNU_SOURCE
+#endif
+
+#include "amp_doorbell.h"
+#include "amp_doorbell_internal.h"
+#include "amp_shmem.h"
+
+#if defined(__ARM_ARCH_PROFILE) && __ARM_ARCH_PROFILE == 'M'
+
+/**
+ * Sleep until the next event
+ * SEV from the other core, or any interrupt, ends the WFE; deadlines are
+ * therefore only as precise as the interrupts the core receives
+ */
+__attribute__((weak)) void amp_doorbell_sleep(amp_atomic_u32_t *word, uint32_t value,
+                                              amp_time_t deadline)
+{
+    if (amp_atomic_load_relaxed(word) == value && !amp_time_expired(deadline)) {
+        __asm__ volatile("wfe" ::: "memory");
+    }
+}
+
+/**
+ * Signal an event to every core
+ */
+__attribute__((weak)) void amp_doorbell_wake(amp_atomic_u32_t *word)
+{
+    (void)word;
+    __asm__ volatile("dsb\n\tsev" ::: "memory");
+}
+
+#elif defined(__linux__)
+
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * Sleep on the doorbell word with a futex
+ * Shared (not private) futexes also work between host-process cores
+ */
+__attribute__((weak)) void amp_doorbell_sleep(amp_atomic_u32_t *word, uint32_t value,
+                                              amp_time_t deadline)
+{
+    struct timespec ts;
+    struct timespec *timeout = NULL;
+
+    if (deadline != AMP_TIME_FOREVER) {
+        amp_time_t now = amp_time_now_us();
+        if (now >= deadline) {
+            return;
+        }
+
+        amp_time_t remaining = deadline - now;
+        ts.tv_sec = (time_t)(remaining / 1000000u);
+        ts.tv_nsec = (long)(remaining % 1000000u) * 1000;
+        timeout = &ts;
+    }
+
+    (void)syscall(SYS_futex, word, FUTEX_WAIT, value, timeout, NULL, 0);
+}
+
+/**
+ * Wake every waiter sleeping on the doorbell word
+ */
+__attribute__((weak)) void amp_doorbell_wake(amp_atomic_u32_t *word)
+{
+    (void)syscall(SYS_futex, word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+#else
+
+/**
+ * No sleep primitive: waiters keep polling
+ */
+__attribute__((weak)) void amp_doorbell_sleep(amp_atomic_u32_t *word, uint32_t value,
+                                              amp_time_t deadline)
+{
+    (void)word;
+    (void)value;
+    (void)deadline;
+}
+
+/**
+ * No sleep primitive: nothing to wake
+ */
+__attribute__((weak)) void amp_doorbell_wake(amp_atomic_u32_t *word)
+{
+    (void)word;
+}
+
+#endif /* __ARM_ARCH_PROFILE == 'M' */
+
+/**
+ * Create a doorbell
+ */
+amp_doorbell_t amp_doorbell_create(void)
+{
+    struct amp_doorbell_s *db = amp_shmem_alloc_aligned(sizeof(struct amp_doorbell_s),
+                                                        AMP_LAYOUT_ALIGN);
+    if (!db) {
+        return NULL;
+    }
+
+    amp_doorbell_init(db);
+
+    return db;
+}
+
+/**
+ * Destroy a doorbell
+ */
+void amp_doorbell_destroy(amp_doorbell_t db)
+{
+    /* Simple allocator doesn't support individual frees */
+    (void)db;
+}
+
+/**
+ * Wake every core waiting on the doorbell
+ */
+void amp_doorbell_ring(amp_doorbell_t db)
+{
+    if (!db) {
+        return;
+    }
+
+    /* Waiters of an explicit polling policy never register, so there is
+     * nobody to wake: skip the fence. AMP_WAIT_DEFAULT resolves on the
+     * waiter's core and may mean sleep there
+     */
+    uint32_t policy = amp_atomic_load_relaxed(&db->policy);
+    if (policy != AMP_WAIT_DEFAULT && policy != AMP_WAIT_SLEEP) {
+        return;
+    }
+
+    /* Pairs with the waiter's fence: the published state must be visible
+     * before waiters is read
+     */
+    amp_atomic_fence_seq_cst();
+
+    if (amp_atomic_load_relaxed(&db->waiters) != 0) {
+        (void)amp_atomic_fetch_add(&db->seq, 1u);
+        amp_doorbell_wake(&db->seq);
+    }
+}
+
+/**
+ * Set how waiters on the doorbell wait after the initial spin
+ */
+int amp_doorbell_set_policy(amp_doorbell_t db, amp_wait_policy_t policy)
+{
+    if (!db || policy > AMP_WAIT_YIELD) {
+        return -1;
+    }
+
+    amp_atomic_store_relaxed(&db->policy, (uint32_t)policy);
+
+    return 0;
+}
+
+/**
+ * Short spin first: wakeups that arrive quickly skip the sleep
+ */
+int amp_doorbell_spin(amp_doorbell_cond_t cond, void *arg, amp_time_t deadline)
+{
+    for (uint32_t i = 0; i < AMP_DOORBELL_SPIN; i++) {
+        if (cond(arg)) {
+            return 0;
+        }
+        if (amp_time_expired(deadline)) {
+            return -1;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * Keep checking a condition without sleeping on the doorbell
+ * Waiters never register, so ringers skip the wakeup entirely
+ */
+int amp_doorbell_poll(amp_doorbell_cond_t cond, void *arg, amp_time_t deadline,
+                      amp_wait_policy_t policy)
+{
+    uint32_t pause = 1;
+
+    while (1) {
+        if (cond(arg)) {
+            return 0;
+        }
+        if (amp_time_expired(deadline)) {
+            return -1;
+        }
+
+        if (policy == AMP_WAIT_YIELD) {
+            amp_wait_yield();
+        } else if (policy == AMP_WAIT_BACKOFF) {
+            for (uint32_t i = 0; i < pause; i++) {
+                amp_wait_relax();
+            }
+            if (pause < AMP_WAIT_BACKOFF_MAX) {
+                pause *= 2;
+            }
+        }
+    }
+}
+
+/**
+ * Wait until a condition holds, sleeping between rings
+ */
+int amp_doorbell_wait_for(amp_doorbell_t db, amp_doorbell_cond_t cond, void *arg,
+                          amp_time_t deadline)
+{
+    if (!db || !cond) {
+        return -1;
+    }
+
+    int result = amp_doorbell_spin(cond, arg, deadline);
+    if (result <= 0) {
+        return result;
+    }
+
+    amp_wait_policy_t policy = (amp_wait_policy_t)amp_atomic_load_relaxed(&db->policy);
+    if (policy == AMP_WAIT_DEFAULT) {
+        policy = amp_wait_get_default_policy();
+    }
+    if (policy != AMP_WAIT_SLEEP) {
+        return amp_doorbell_poll(cond, arg, deadline, policy);
+    }
+
+    while (1) {
+        /* Register before the last check, so a ring after it is not missed:
+         * the fence pairs with the ringer's, and the acquire keeps the
+         * condition from being read ahead of seq
+         */
+        (void)amp_atomic_fetch_add(&db->waiters, 1u);
+        amp_atomic_fence_seq_cst();
+        uint32_t seq = amp_atomic_load_acquire(&db->seq);
+
+        bool done = cond(arg);
+        bool expired = !done && amp_time_expired(deadline);
+        if (!done && !expired) {
+            amp_doorbell_sleep(&db->seq, seq, deadline);
+        }
+
+        (void)amp_atomic_fetch_sub(&db->waiters, 1u);
+
+        if (done) {
+            return 0;
+        }
+        if (expired) {
+            return -1;
+        }
+    }
+}
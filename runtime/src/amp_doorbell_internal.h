@@ -0,0 +1,61 @@
+/**
+ * @file amp_doorbell_internal.h
+ * @brief Doorbell Layout for Embedding in IPC Control Blocks
+ *
+ * IPC primitives embed their doorbells in their own control blocks so that
+ * a single allocation holds the queue and its notifications.
+ */
+
+#ifndef AMP_DOORBELL_INTERNAL_H
+#define AMP_DOORBELL_INTERNAL_H
+
+#include "amp_atomic.h"
+#include "amp_doorbell.h"
+#include "amp_layout.h"
+#include "amp_wait.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Doorbell state in shared memory
+ * seq is bumped by ringers while waiters is non-zero; both sides write the
+ * block, so it gets a line of its own in the padded layout. Ringers read
+ * policy too: waiters of a polling policy never register
+ */
+struct amp_doorbell_s {
+    AMP_LAYOUT_LINE amp_atomic_u32_t seq;
+    amp_atomic_u32_t waiters;
+    amp_atomic_u32_t policy;    /* amp_wait_policy_t of waiters */
+};
+
+/**
+ * Initialize an embedded doorbell
+ */
+static inline void amp_doorbell_init(struct amp_doorbell_s *db)
+{
+    amp_atomic_store_relaxed(&db->seq, 0);
+    amp_atomic_store_relaxed(&db->waiters, 0);
+    amp_atomic_store_relaxed(&db->policy, AMP_WAIT_DEFAULT);
+}
+
+/**
+ * Check a condition for AMP_DOORBELL_SPIN rounds
+ *
+ * @return 0 once cond holds, -1 on timeout, 1 to keep waiting
+ */
+int amp_doorbell_spin(amp_doorbell_cond_t cond, void *arg, amp_time_t deadline);
+
+/**
+ * Keep checking a condition as a non-sleeping wait policy says
+ *
+ * @return 0 once cond holds, -1 on timeout
+ */
+int amp_doorbell_poll(amp_doorbell_cond_t cond, void *arg, amp_time_t deadline,
+                      amp_wait_policy_t policy);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMP_DOORBELL_INTERNAL_H */
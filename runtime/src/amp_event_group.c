@@ -0,0 +1,181 @@
+/**
+ * @file amp_event_group.c
+ * @brief Inter-Core Event Group Implementation
+ */
+
+#include "amp_event_group.h"
+#include "amp_shmem.h"
+#include "amp_atomic.h"
+#include "amp_doorbell_internal.h"
+#include "amp_layout.h"
+
+/* Event group structure in shared memory
+ * The bits are written by every core
+ */
+struct amp_event_group_s {
+    AMP_LAYOUT_LINE amp_atomic_u32_t bits;
+    struct amp_doorbell_s bell;     /* Rung by every set */
+};
+
+/* Wait for bits, see amp_event_group_wait_bits_until() */
+typedef struct {
+    amp_event_group_t group;
+    uint32_t mask;
+    amp_event_wait_t mode;
+    bool clear_on_exit;
+    uint32_t result;        /* Bits that satisfied the wait */
+} event_wait_t;
+
+/**
+ * Create an event group
+ */
+amp_event_group_t amp_event_group_create(uint32_t initial_bits)
+{
+    struct amp_event_group_s *group = amp_shmem_alloc_aligned(sizeof(struct amp_event_group_s),
+                                                              AMP_LAYOUT_ALIGN);
+    if (!group) {
+        return NULL;
+    }
+
+    amp_atomic_store_relaxed(&group->bits, initial_bits);
+    amp_doorbell_init(&group->bell);
+
+    /* Initialization completes before the handle reaches another core */
+    amp_atomic_fence_release();
+
+    return group;
+}
+
+/**
+ * Destroy an event group
+ */
+void amp_event_group_destroy(amp_event_group_t group)
+{
+    /* Simple allocator doesn't support individual frees */
+    (void)group;
+}
+
+/**
+ * Set how blocking calls on the event group wait
+ */
+int amp_event_group_set_wait_policy(amp_event_group_t group, amp_wait_policy_t policy)
+{
+    if (!group) {
+        return -1;
+    }
+
+    return amp_doorbell_set_policy(&group->bell, policy);
+}
+
+/**
+ * Set bits and wake the waiters
+ */
+uint32_t amp_event_group_set_bits(amp_event_group_t group, uint32_t bits)
+{
+    if (!group) {
+        return 0;
+    }
+
+    /* Release: the setter's accesses complete before the bits appear */
+    uint32_t prev = amp_atomic_fetch_or(&group->bits, bits);
+    amp_doorbell_ring(&group->bell);
+
+    return prev;
+}
+
+/**
+ * Clear bits
+ */
+uint32_t amp_event_group_clear_bits(amp_event_group_t group, uint32_t bits)
+{
+    if (!group) {
+        return 0;
+    }
+
+    return amp_atomic_fetch_and(&group->bits, ~bits);
+}
+
+/**
+ * Get the bits currently set
+ */
+uint32_t amp_event_group_get_bits(amp_event_group_t group)
+{
+    if (!group) {
+        return 0;
+    }
+
+    return amp_atomic_load_acquire(&group->bits);
+}
+
+/**
+ * Check whether bits satisfy a wait
+ */
+static bool event_match(uint32_t bits, uint32_t mask, amp_event_wait_t mode)
+{
+    return mode == AMP_EVENT_WAIT_ALL ? (bits & mask) == mask : (bits & mask) != 0;
+}
+
+/**
+ * Doorbell condition: the bits satisfy the wait, cleared if asked
+ */
+static bool event_wait_cond(void *arg)
+{
+    event_wait_t *wait = (event_wait_t *)arg;
+
+    /* Acquire: the waiter's accesses stay after it sees the bits */
+    uint32_t bits = amp_atomic_load_acquire(&wait->group->bits);
+    while (event_match(bits, wait->mask, wait->mode)) {
+        if (!wait->clear_on_exit ||
+            amp_atomic_cas(&wait->group->bits, &bits, bits & ~wait->mask)) {
+            wait->result = bits;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Check for bits (non-blocking)
+ */
+uint32_t amp_event_group_try_wait_bits(amp_event_group_t group, uint32_t mask,
+                                       amp_event_wait_t mode, bool clear_on_exit)
+{
+    if (!group || mask == 0) {
+        return 0;
+    }
+
+    event_wait_t wait = { group, mask, mode, clear_on_exit, 0 };
+
+    return event_wait_cond(&wait) ? wait.result : 0;
+}
+
+/**
+ * Wait for bits (blocking)
+ */
+uint32_t amp_event_group_wait_bits(amp_event_group_t group, uint32_t mask,
+                                   amp_event_wait_t mode, bool clear_on_exit,
+                                   uint32_t timeout_ms)
+{
+    return amp_event_group_wait_bits_until(group, mask, mode, clear_on_exit,
+                                           amp_time_deadline_ms(timeout_ms));
+}
+
+/**
+ * Wait for bits (blocking until an absolute deadline)
+ */
+uint32_t amp_event_group_wait_bits_until(amp_event_group_t group, uint32_t mask,
+                                         amp_event_wait_t mode, bool clear_on_exit,
+                                         amp_time_t deadline)
+{
+    if (!group || mask == 0) {
+        return 0;
+    }
+
+    event_wait_t wait = { group, mask, mode, clear_on_exit, 0 };
+    if (amp_doorbell_wait_for(&group->bell, event_wait_cond, &wait, deadline) != 0) {
+        return 0;
+    }
+
+    return wait.result;
+}
@@ -0,0 +1,235 @@
+/**
+ * @file amp_latest.c
+ * @brief Latest-Value Channel Implementation
+ */
+
+#include "amp_latest.h"
+#include "amp_shmem.h"
+#include "amp_atomic.h"
+#include "amp_copy.h"
+#include "amp_layout.h"
+
+/* Set in the middle slot while it holds a value the consumer has not taken */
+#define LATEST_FRESH 4u
+
+/* Buffer index in a slot */
+#define LATEST_INDEX 3u
+
+/* Header in front of each buffer's data */
+typedef struct {
+    uint32_t len;
+} latest_buffer_t;
+
+/* Latest-value channel structure in shared memory
+ * Each of the three buffers is owned by exactly one of the producer (back),
+ * the consumer (front) or the middle slot at any time; ownership changes
+ * only by swapping indices with middle.
+ */
+struct amp_latest_s {
+    AMP_LAYOUT_LINE amp_atomic_u32_t middle;    /* Shared: index | LATEST_FRESH */
+    AMP_LAYOUT_LINE uint32_t back;              /* Producer */
+    AMP_LAYOUT_LINE uint32_t front;             /* Consumer */
+    uint32_t has_value;     /* Consumer took a value at least once */
+    uint32_t unread;        /* Front value not yet returned by a read */
+    AMP_LAYOUT_LINE uint32_t size;              /* Configuration */
+    uint32_t stride;        /* Bytes between consecutive buffers */
+    AMP_LAYOUT_LINE char buffers[];     /* Three buffers follow */
+};
+
+/**
+ * Get a buffer by index
+ */
+static latest_buffer_t *latest_buffer(amp_latest_t latest, uint32_t index)
+{
+    return (latest_buffer_t *)(void *)&latest->buffers[index * latest->stride];
+}
+
+/**
+ * Get the data of a buffer
+ */
+static void *latest_data(latest_buffer_t *buf)
+{
+    return buf + 1;
+}
+
+/**
+ * Create a latest-value channel
+ */
+amp_latest_t amp_latest_create(size_t size)
+{
+    if (size == 0 || size > UINT32_MAX - sizeof(latest_buffer_t) - AMP_LAYOUT_ALIGN) {
+        return NULL;
+    }
+
+    size_t stride = (sizeof(latest_buffer_t) + size + AMP_LAYOUT_ALIGN - 1) &
+                    ~(size_t)(AMP_LAYOUT_ALIGN - 1);
+    size_t total_size = sizeof(struct amp_latest_s) + 3 * stride;
+    struct amp_latest_s *latest = amp_shmem_alloc_aligned(total_size, AMP_LAYOUT_ALIGN);
+
+    if (!latest) {
+        return NULL;
+    }
+
+    latest->back = 0;
+    amp_atomic_store_relaxed(&latest->middle, 1);
+    latest->front = 2;
+    latest->has_value = 0;
+    latest->unread = 0;
+    latest->size = (uint32_t)size;
+    latest->stride = (uint32_t)stride;
+    for (uint32_t i = 0; i < 3; i++) {
+        latest_buffer(latest, i)->len = 0;
+    }
+
+    /* Initialization completes before the handle reaches another core */
+    amp_atomic_fence_release();
+
+    return latest;
+}
+
+/**
+ * Destroy a latest-value channel
+ */
+void amp_latest_destroy(amp_latest_t latest)
+{
+    /* Simple allocator doesn't support individual frees */
+    (void)latest;
+}
+
+/**
+ * Get the producer's buffer
+ */
+void *amp_latest_acquire_tx_buffer(amp_latest_t latest)
+{
+    if (!latest) {
+        return NULL;
+    }
+
+    return latest_data(latest_buffer(latest, latest->back));
+}
+
+/**
+ * Publish the producer's buffer
+ */
+int amp_latest_commit_tx(amp_latest_t latest, uint32_t len)
+{
+    if (!latest || len > latest->size) {
+        return -1;
+    }
+
+    latest_buffer(latest, latest->back)->len = len;
+
+    /* Release: the value is complete before it becomes the middle. Acquire:
+     * the consumer has finished with the buffer handed back
+     */
+    uint32_t prev = amp_atomic_exchange(&latest->middle, latest->back | LATEST_FRESH);
+    latest->back = prev & LATEST_INDEX;
+
+    return 0;
+}
+
+/**
+ * Publish a value
+ */
+int amp_latest_publish(amp_latest_t latest, const void *data, uint32_t len)
+{
+    if (!latest || (!data && len > 0) || len > latest->size) {
+        return -1;
+    }
+
+    amp_copy(latest_data(latest_buffer(latest, latest->back)), data, len);
+
+    return amp_latest_commit_tx(latest, len);
+}
+
+/**
+ * Swap in the middle buffer if it is fresh
+ * Returns true if the consumer's buffer changed
+ */
+static bool latest_take(amp_latest_t latest)
+{
+    if (!(amp_atomic_load_relaxed(&latest->middle) & LATEST_FRESH)) {
+        return false;
+    }
+
+    /* Acquire: the value is not read ahead of the swap. Release: reads of
+     * the buffer handed back are done before the producer can reuse it
+     */
+    uint32_t prev = amp_atomic_exchange(&latest->middle, latest->front);
+    latest->front = prev & LATEST_INDEX;
+    latest->has_value = 1;
+    latest->unread = 1;
+
+    return true;
+}
+
+/**
+ * Access the newest value in place
+ */
+const void *amp_latest_acquire_rx_buffer(amp_latest_t latest, uint32_t *len)
+{
+    if (!latest) {
+        return NULL;
+    }
+
+    latest_take(latest);
+    if (!latest->has_value) {
+        return NULL;
+    }
+
+    latest_buffer_t *buf = latest_buffer(latest, latest->front);
+    if (len) {
+        *len = buf->len;
+    }
+    latest->unread = 0;
+
+    return latest_data(buf);
+}
+
+/**
+ * Read the newest value
+ */
+int amp_latest_read(amp_latest_t latest, void *data, uint32_t max_len, uint32_t *len)
+{
+    if (!latest || !data) {
+        return -1;
+    }
+
+    latest_take(latest);
+    if (!latest->has_value) {
+        return -1;
+    }
+
+    /* A value too large for the buffer stays unread for the next read */
+    latest_buffer_t *buf = latest_buffer(latest, latest->front);
+    if (buf->len > max_len) {
+        return -1;
+    }
+
+    amp_copy(data, latest_data(buf), buf->len);
+    if (len) {
+        *len = buf->len;
+    }
+
+    bool fresh = latest->unread != 0;
+    latest->unread = 0;
+
+    return fresh ? 1 : 0;
+}
+
+/**
+ * Check for a value newer than the last read
+ */
+bool amp_latest_has_new(amp_latest_t latest)
+{
+    return latest && (latest->unread ||
+                      (amp_atomic_load_relaxed(&latest->middle) & LATEST_FRESH) != 0);
+}
+
+/**
+ * Get the maximum value size
+ */
+size_t amp_latest_size(amp_latest_t latest)
+{
+    return latest ? latest->size : 0;
+}
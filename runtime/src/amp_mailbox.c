@@ -5,30 +5,186 @@
 
 #include "amp_mailbox.h"
 #include "amp_shmem.h"
-#include "amp_barriers.h"
+#include "amp_atomic.h"
+#include "amp_doorbell_internal.h"
+#include "amp_layout.h"
+#include "amp_poll_internal.h"
+#include "amp_time.h"
 #include <string.h>
 
-/* Mailbox structure in shared memory */
+/* Mailbox structure in shared memory
+ * Producer-owned, consumer-owned and immutable fields are grouped so that
+ * AMP_LAYOUT_PADDED can put each group on its own cache line
+ */
 struct amp_mailbox_s {
-    volatile uint32_t write_idx;
-    volatile uint32_t read_idx;
-    uint32_t msg_size;
+    AMP_LAYOUT_LINE amp_atomic_u32_t write_idx;     /* Producer */
+    AMP_LAYOUT_LINE amp_atomic_u32_t read_idx;      /* Consumer */
+    struct amp_doorbell_s rx_bell;  /* Rung by the producer after publishing */
+    struct amp_doorbell_s tx_bell;  /* Rung by the consumer after freeing slots */
+    AMP_LAYOUT_LINE uint32_t msg_size;              /* Configuration */
     uint32_t msg_slots;
     uint32_t mask;  /* msg_slots - 1, for fast modulo */
-    char data[];    /* Message data follows */
+    uint32_t mode;
+    uint32_t slot_size;     /* Bytes per slot, including any slot header */
+    uint32_t lanes;         /* Priority lanes in data[], 0 for a plain mailbox */
+    uint32_t lane_stride;   /* Bytes between consecutive lanes */
+    amp_poll_link_t poll;   /* Poll set notified after publishing */
+    AMP_LAYOUT_LINE __attribute__((aligned(8))) char data[];    /* Message data follows */
 };
 
+/* Priority mailbox block, stored in the data[] of the parent mailbox
+ * Lane n is a plain mailbox at lanes[n * lane_stride]
+ */
+typedef struct {
+    AMP_LAYOUT_LINE amp_atomic_u32_t ready;         /* Bit n set while lane n may hold messages */
+    AMP_LAYOUT_LINE amp_atomic_u32_t drops[AMP_MAILBOX_MAX_LANES];     /* Producer */
+    AMP_LAYOUT_LINE __attribute__((aligned(8))) char lanes[];
+} amp_mailbox_prio_t;
+
+/* Variable mode record header
+ * Each record is a uint32_t payload length followed by the payload padded
+ * to 4 bytes; MAILBOX_RECORD_WRAP marks an unused arena tail
+ */
+#define MAILBOX_RECORD_WRAP 0xFFFFFFFFu
+
+/* Largest variable mode arena in bytes */
+#define MAILBOX_MAX_ARENA (1u << 30)
+
+/* Sequenced and MPSC mode slot header
+ * Slot i holds seq == pos when free for the producer at position pos, and
+ * seq == pos + 1 once the message for pos is published
+ */
+typedef struct {
+    amp_atomic_u32_t seq;
+    uint32_t reserved;      /* Keeps the payload 8-byte aligned */
+} amp_mailbox_slot_t;
+
 /**
- * Create a mailbox
+ * Get the start of a slot
  */
-amp_mailbox_t amp_mailbox_create(const amp_mailbox_config_t *config)
+static inline char *mailbox_slot(amp_mailbox_t mbox, uint32_t idx)
 {
-    if (!config || config->msg_size == 0 || config->msg_slots == 0) {
-        return NULL;
+    return &mbox->data[(idx & mbox->mask) * mbox->slot_size];
+}
+
+/**
+ * Get the header of a slot in sequenced or MPSC mode
+ */
+static inline amp_mailbox_slot_t *mailbox_seq_slot(amp_mailbox_t mbox, uint32_t idx)
+{
+    return (amp_mailbox_slot_t *)mailbox_slot(mbox, idx);
+}
+
+/**
+ * Check whether a mailbox uses per-slot sequence words
+ */
+static inline bool mailbox_sequenced(amp_mailbox_t mbox)
+{
+    return mbox->mode == AMP_MAILBOX_MODE_SEQUENCED || mbox->mode == AMP_MAILBOX_MODE_MPSC;
+}
+
+/**
+ * Check whether batch and slot lease calls apply: a plain mailbox with
+ * fixed-size slots
+ */
+static inline bool mailbox_fixed(amp_mailbox_t mbox)
+{
+    return !mbox->lanes && mbox->mode != AMP_MAILBOX_MODE_VARIABLE;
+}
+
+/**
+ * Get the arena size of a variable mode record with a given payload length
+ */
+static inline uint32_t mailbox_record_size(uint32_t len)
+{
+    return (uint32_t)sizeof(uint32_t) + ((len + 3u) & ~3u);
+}
+
+/**
+ * Check whether a plain mailbox or lane has no published message
+ * In sequenced and MPSC modes write_idx also counts claimed slots, so the
+ * consumer's slot is checked instead
+ */
+static inline bool mailbox_empty(amp_mailbox_t mbox)
+{
+    uint32_t read_idx = amp_atomic_load_relaxed(&mbox->read_idx);
+
+    if (mailbox_sequenced(mbox)) {
+        return amp_atomic_load_acquire(&mailbox_seq_slot(mbox, read_idx)->seq) != read_idx + 1;
+    }
+
+    return read_idx == amp_atomic_load_acquire(&mbox->write_idx);
+}
+
+/**
+ * Get the priority block of a priority mailbox
+ */
+static inline amp_mailbox_prio_t *mailbox_prio(amp_mailbox_t mbox)
+{
+    return (amp_mailbox_prio_t *)mbox->data;
+}
+
+/**
+ * Get one lane of a priority mailbox
+ */
+static inline amp_mailbox_t mailbox_lane(amp_mailbox_t mbox, uint32_t lane)
+{
+    return (amp_mailbox_t)&mailbox_prio(mbox)->lanes[lane * mbox->lane_stride];
+}
+
+/**
+ * Validate a configuration and compute its slot geometry
+ * Returns the size of a mailbox control block plus its slots, or 0 if invalid
+ */
+static size_t mailbox_geometry(const amp_mailbox_config_t *config,
+                               uint32_t *slots_out, uint32_t *slot_size_out)
+{
+    if (!config || config->msg_size == 0) {
+        return 0;
     }
 
-    /* Ensure msg_slots is power of 2 for efficient indexing */
     uint32_t slots = config->msg_slots;
+    uint32_t slot_size;
+    switch (config->mode) {
+    case AMP_MAILBOX_MODE_INDEXED:
+        slot_size = config->msg_size;
+        break;
+    case AMP_MAILBOX_MODE_SEQUENCED:
+    case AMP_MAILBOX_MODE_MPSC:
+        slot_size = (uint32_t)sizeof(amp_mailbox_slot_t) + ((config->msg_size + 7u) & ~7u);
+        break;
+    case AMP_MAILBOX_MODE_VARIABLE: {
+        /* Byte arena, so "slots" are bytes. Any two maximum records must
+         * fit, so a record that skips the arena tail finds room at the start
+         */
+        if (config->msg_size > MAILBOX_MAX_ARENA / 2) {
+            return 0;
+        }
+        uint64_t record = mailbox_record_size(config->msg_size);
+        uint64_t arena = config->arena_size ? config->arena_size
+                                            : (uint64_t)config->msg_slots * record;
+        if (arena < 2 * record) {
+            if (config->arena_size) {
+                return 0;
+            }
+            arena = 2 * record;
+        }
+        if (arena > MAILBOX_MAX_ARENA) {
+            return 0;
+        }
+        slots = (uint32_t)arena;
+        slot_size = 1;
+        break;
+    }
+    default:
+        return 0;
+    }
+
+    if (slots == 0) {
+        return 0;
+    }
+
+    /* Ensure msg_slots is power of 2 for efficient indexing */
     if ((slots & (slots - 1)) != 0) {
         /* Round up to next power of 2 */
         slots--;
@@ -40,18 +196,112 @@ amp_mailbox_t amp_mailbox_create(const amp_mailbox_config_t *config)
         slots++;
     }
 
-    size_t total_size = sizeof(struct amp_mailbox_s) + (config->msg_size * slots);
-    struct amp_mailbox_s *mbox = amp_shmem_alloc(total_size);
+    *slots_out = slots;
+    *slot_size_out = slot_size;
+
+    return sizeof(struct amp_mailbox_s) + ((size_t)slot_size * slots);
+}
+
+/**
+ * Initialize a mailbox control block and its slots
+ */
+static void mailbox_init(amp_mailbox_t mbox, const amp_mailbox_config_t *config,
+                         uint32_t slots, uint32_t slot_size)
+{
+    amp_atomic_store_relaxed(&mbox->write_idx, 0);
+    amp_atomic_store_relaxed(&mbox->read_idx, 0);
+    mbox->msg_size = config->msg_size;
+    mbox->msg_slots = slots;
+    mbox->mask = slots - 1;
+    mbox->mode = config->mode;
+    mbox->slot_size = slot_size;
+    mbox->lanes = 0;
+    mbox->lane_stride = 0;
+    amp_doorbell_init(&mbox->rx_bell);
+    amp_doorbell_init(&mbox->tx_bell);
+    amp_poll_link_init(&mbox->poll);
+
+    /* Every slot starts free for the producer's first lap */
+    if (mailbox_sequenced(mbox)) {
+        for (uint32_t i = 0; i < slots; i++) {
+            amp_atomic_store_relaxed(&mailbox_seq_slot(mbox, i)->seq, i);
+        }
+    }
+}
+
+/**
+ * Create a mailbox
+ */
+amp_mailbox_t amp_mailbox_create(const amp_mailbox_config_t *config)
+{
+    uint32_t slots;
+    uint32_t slot_size;
+    size_t total_size = mailbox_geometry(config, &slots, &slot_size);
+
+    if (total_size == 0) {
+        return NULL;
+    }
+
+    struct amp_mailbox_s *mbox = amp_shmem_alloc_aligned(total_size, AMP_LAYOUT_ALIGN);
     
     if (!mbox) {
         return NULL;
     }
 
-    mbox->write_idx = 0;
-    mbox->read_idx = 0;
-    mbox->msg_size = config->msg_size;
-    mbox->msg_slots = slots;
-    mbox->mask = slots - 1;
+    mailbox_init(mbox, config, slots, slot_size);
+
+    /* Initialization completes before the handle reaches another core */
+    amp_atomic_fence_release();
+
+    return mbox;
+}
+
+/**
+ * Create a mailbox with priority lanes
+ */
+amp_mailbox_t amp_mailbox_create_priority(const amp_mailbox_config_t *config, uint32_t lanes)
+{
+    if (lanes == 0 || lanes > AMP_MAILBOX_MAX_LANES) {
+        return NULL;
+    }
+
+    /* Lanes need fixed-size slots */
+    if (config && config->mode == AMP_MAILBOX_MODE_VARIABLE) {
+        return NULL;
+    }
+
+    uint32_t slots;
+    uint32_t slot_size;
+    size_t lane_size = mailbox_geometry(config, &slots, &slot_size);
+
+    if (lane_size == 0) {
+        return NULL;
+    }
+
+    /* Lanes follow each other in one block, each starting on a fresh line */
+    size_t lane_stride = (lane_size + AMP_LAYOUT_ALIGN - 1) & ~(size_t)(AMP_LAYOUT_ALIGN - 1);
+    size_t total_size = sizeof(struct amp_mailbox_s) + sizeof(amp_mailbox_prio_t) +
+                        lane_stride * lanes;
+    struct amp_mailbox_s *mbox = amp_shmem_alloc_aligned(total_size, AMP_LAYOUT_ALIGN);
+
+    if (!mbox) {
+        return NULL;
+    }
+
+    mailbox_init(mbox, config, slots, slot_size);
+    mbox->lanes = lanes;
+    mbox->lane_stride = (uint32_t)lane_stride;
+
+    amp_mailbox_prio_t *prio = mailbox_prio(mbox);
+    amp_atomic_store_relaxed(&prio->ready, 0);
+    for (uint32_t i = 0; i < AMP_MAILBOX_MAX_LANES; i++) {
+        amp_atomic_store_relaxed(&prio->drops[i], 0);
+    }
+    for (uint32_t i = 0; i < lanes; i++) {
+        mailbox_init(mailbox_lane(mbox, i), config, slots, slot_size);
+    }
+
+    amp_atomic_fence_release();
 
     return mbox;
 }
@@ -66,16 +316,189 @@ void amp_mailbox_destroy(amp_mailbox_t mbox)
 }
 
 /**
- * Try to send a message (non-blocking)
+ * Set how blocking calls on the mailbox wait
  */
-int amp_mailbox_try_send(amp_mailbox_t mbox, const void *msg)
+int amp_mailbox_set_wait_policy(amp_mailbox_t mbox, amp_wait_policy_t policy)
 {
-    if (!mbox || !msg) {
+    if (!mbox || amp_doorbell_set_policy(&mbox->rx_bell, policy) != 0) {
+        return -1;
+    }
+
+    return amp_doorbell_set_policy(&mbox->tx_bell, policy);
+}
+
+/**
+ * Claim a run of up to n free slots in sequenced or MPSC mode
+ * A single producer just advances its own index; in MPSC mode producers
+ * race for the run with a compare-and-swap on write_idx. Claimed slots stay
+ * invisible to the consumer until their sequence words are published.
+ * Returns the number of slots claimed, starting at *pos_out
+ */
+static uint32_t mailbox_seq_claim(amp_mailbox_t mbox, uint32_t n, uint32_t *pos_out)
+{
+    uint32_t pos = amp_atomic_load_relaxed(&mbox->write_idx);
+
+    for (;;) {
+        /* Slots still holding a message from the previous lap end the run.
+         * Acquire: the payload is written only after the consumer freed it
+         */
+        uint32_t count = 0;
+        while (count < n &&
+               amp_atomic_load_acquire(&mailbox_seq_slot(mbox, pos + count)->seq) == pos + count) {
+            count++;
+        }
+
+        if (mbox->mode != AMP_MAILBOX_MODE_MPSC) {
+            if (count > 0) {
+                amp_atomic_store_relaxed(&mbox->write_idx, pos + count);
+            }
+            *pos_out = pos;
+            return count;
+        }
+
+        if (count == 0) {
+            /* Full, unless another producer claimed pos after it was read */
+            if ((int32_t)(amp_atomic_load_acquire(&mailbox_seq_slot(mbox, pos)->seq) - pos) < 0) {
+                return 0;
+            }
+            pos = amp_atomic_load_relaxed(&mbox->write_idx);
+            continue;
+        }
+
+        /* On failure pos becomes the index another producer moved it to */
+        if (amp_atomic_cas(&mbox->write_idx, &pos, pos + count)) {
+            *pos_out = pos;
+            return count;
+        }
+    }
+}
+
+/**
+ * Try to send a message in sequenced or MPSC mode
+ * Only touches the producers' index and the target slot
+ */
+static int mailbox_seq_try_send(amp_mailbox_t mbox, const void *msg)
+{
+    uint32_t pos;
+
+    if (mailbox_seq_claim(mbox, 1, &pos) == 0) {
+        return -1;
+    }
+
+    amp_mailbox_slot_t *slot = mailbox_seq_slot(mbox, pos);
+    memcpy(slot + 1, msg, mbox->msg_size);
+
+    /* Release: the payload is complete before the slot is published */
+    amp_atomic_store_release(&slot->seq, pos + 1);
+
+    return 0;
+}
+
+/**
+ * Try to receive a message in sequenced or MPSC mode
+ * Only reads the consumer's own index and the source slot
+ */
+static int mailbox_seq_try_recv(amp_mailbox_t mbox, void *msg)
+{
+    uint32_t pos = amp_atomic_load_relaxed(&mbox->read_idx);
+    amp_mailbox_slot_t *slot = (amp_mailbox_slot_t *)mailbox_slot(mbox, pos);
+
+    /* Message for this position not published yet
+     * Acquire: the payload is not read ahead of the sequence
+     */
+    if (amp_atomic_load_acquire(&slot->seq) != pos + 1) {
+        return -1;
+    }
+
+    memcpy(msg, slot + 1, mbox->msg_size);
+
+    /* Release: the payload is read before the slot goes back for the next lap */
+    amp_atomic_store_release(&slot->seq, pos + mbox->msg_slots);
+    amp_atomic_store_relaxed(&mbox->read_idx, pos + 1);
+
+    return 0;
+}
+
+/**
+ * Try to send a record in variable mode
+ * Records never wrap: one that does not fit before the end of the arena
+ * skips the tail, which is marked so the consumer skips it too
+ */
+static int mailbox_var_try_send(amp_mailbox_t mbox, const void *msg, uint32_t len)
+{
+    uint32_t write_idx = amp_atomic_load_relaxed(&mbox->write_idx);
+    uint32_t tail = mbox->msg_slots - (write_idx & mbox->mask);
+    uint32_t need = mailbox_record_size(len);
+    uint32_t skip = need > tail ? tail : 0;
+
+    /* Check if the arena has room */
+    if ((write_idx - amp_atomic_load_acquire(&mbox->read_idx)) + skip + need > mbox->msg_slots) {
+        return -1;
+    }
+
+    if (skip) {
+        *(uint32_t *)mailbox_slot(mbox, write_idx) = MAILBOX_RECORD_WRAP;
+        write_idx += skip;
+    }
+
+    /* Copy only the bytes in use */
+    char *record = mailbox_slot(mbox, write_idx);
+    *(uint32_t *)record = len;
+    memcpy(record + sizeof(uint32_t), msg, len);
+
+    /* Release: the record is complete before the write index covers it */
+    amp_atomic_store_release(&mbox->write_idx, write_idx + need);
+
+    return 0;
+}
+
+/**
+ * Try to receive a record in variable mode
+ * The buffer must hold msg_size bytes
+ */
+static int mailbox_var_try_recv(amp_mailbox_t mbox, void *msg, uint32_t *len)
+{
+    uint32_t read_idx = amp_atomic_load_relaxed(&mbox->read_idx);
+
+    /* Check if mailbox is empty
+     * Acquire: the record is not read ahead of the write index
+     */
+    if (read_idx == amp_atomic_load_acquire(&mbox->write_idx)) {
         return -1;
     }
 
-    uint32_t write_idx = mbox->write_idx;
-    uint32_t read_idx = mbox->read_idx;
+    uint32_t record_len = *(uint32_t *)mailbox_slot(mbox, read_idx);
+    if (record_len == MAILBOX_RECORD_WRAP) {
+        read_idx += mbox->msg_slots - (read_idx & mbox->mask);
+        record_len = *(uint32_t *)mailbox_slot(mbox, read_idx);
+    }
+
+    memcpy(msg, mailbox_slot(mbox, read_idx) + sizeof(uint32_t), record_len);
+    *len = record_len;
+
+    /* Release: the record is read before its space is handed back */
+    amp_atomic_store_release(&mbox->read_idx, read_idx + mailbox_record_size(record_len));
+
+    return 0;
+}
+
+/**
+ * Try to send a message to a plain mailbox or lane
+ */
+static int mailbox_try_send(amp_mailbox_t mbox, const void *msg)
+{
+    if (mailbox_sequenced(mbox)) {
+        return mailbox_seq_try_send(mbox, msg);
+    }
+
+    /* Plain sends to a variable mode mailbox carry msg_size bytes */
+    if (mbox->mode == AMP_MAILBOX_MODE_VARIABLE) {
+        return mailbox_var_try_send(mbox, msg, mbox->msg_size);
+    }
+
+    /* Acquire: the slot is not overwritten before the consumer has read it */
+    uint32_t write_idx = amp_atomic_load_relaxed(&mbox->write_idx);
+    uint32_t read_idx = amp_atomic_load_acquire(&mbox->read_idx);
 
     /* Check if mailbox is full */
     if (write_idx - read_idx >= mbox->msg_slots) {
@@ -83,80 +506,845 @@ int amp_mailbox_try_send(amp_mailbox_t mbox, const void *msg)
     }
 
     /* Copy message */
-    uint32_t slot = write_idx & mbox->mask;
-    void *dest = &mbox->data[slot * mbox->msg_size];
-    memcpy(dest, msg, mbox->msg_size);
+    memcpy(mailbox_slot(mbox, write_idx), msg, mbox->msg_size);
 
-    /* Memory barrier before updating write index */
-    AMP_DMB();
-    mbox->write_idx = write_idx + 1;
+    /* Release: the message is complete before the write index covers it */
+    amp_atomic_store_release(&mbox->write_idx, write_idx + 1);
 
     return 0;
 }
 
 /**
- * Try to receive a message (non-blocking)
+ * Try to receive a message from a plain mailbox or lane
  */
-int amp_mailbox_try_recv(amp_mailbox_t mbox, void *msg)
+static int mailbox_try_recv(amp_mailbox_t mbox, void *msg)
 {
-    if (!mbox || !msg) {
-        return -1;
+    if (mailbox_sequenced(mbox)) {
+        return mailbox_seq_try_recv(mbox, msg);
+    }
+
+    if (mbox->mode == AMP_MAILBOX_MODE_VARIABLE) {
+        uint32_t len;
+        return mailbox_var_try_recv(mbox, msg, &len);
     }
 
-    uint32_t write_idx = mbox->write_idx;
-    uint32_t read_idx = mbox->read_idx;
+    /* Acquire: the message is not read ahead of the write index */
+    uint32_t write_idx = amp_atomic_load_acquire(&mbox->write_idx);
+    uint32_t read_idx = amp_atomic_load_relaxed(&mbox->read_idx);
 
-    /* Check if mailbox is empty */
-    if (read_idx >= write_idx) {
+    /* Check if mailbox is empty (indices wrap, so compare for equality) */
+    if (read_idx == write_idx) {
         return -1;
     }
 
     /* Copy message */
-    uint32_t slot = read_idx & mbox->mask;
-    const void *src = &mbox->data[slot * mbox->msg_size];
-    memcpy(msg, src, mbox->msg_size);
+    memcpy(msg, mailbox_slot(mbox, read_idx), mbox->msg_size);
 
-    /* Memory barrier before updating read index */
-    AMP_DMB();
-    mbox->read_idx = read_idx + 1;
+    /* Release: the message is read before its slot is handed back */
+    amp_atomic_store_release(&mbox->read_idx, read_idx + 1);
 
     return 0;
 }
 
 /**
- * Send a message (blocking)
+ * Try to send a message to one lane of a priority mailbox
  */
-int amp_mailbox_send(amp_mailbox_t mbox, const void *msg, uint32_t timeout_ms)
+static int mailbox_prio_try_send(amp_mailbox_t mbox, const void *msg, uint32_t lane)
 {
-    /* Simple busy-wait timeout (Phase 1 limitation)
-     * Production implementations should use hardware timers
-     */
-    uint32_t count = timeout_ms * 1000;
-    
-    while (amp_mailbox_try_send(mbox, msg) != 0) {
-        if (timeout_ms > 0 && --count == 0) {
-            return -1;
-        }
+    if (mailbox_try_send(mailbox_lane(mbox, lane), msg) != 0) {
+        return -1;
     }
-    
+
+    /* Set after the message is published, so the consumer never misses it */
+    (void)amp_atomic_fetch_or(&mailbox_prio(mbox)->ready, 1u << lane);
+
     return 0;
 }
 
 /**
- * Receive a message (blocking)
+ * Clear the ready bit of a lane the consumer found empty
  */
-int amp_mailbox_recv(amp_mailbox_t mbox, void *msg, uint32_t timeout_ms)
+static void mailbox_prio_clear(amp_mailbox_t mbox, uint32_t lane)
 {
-    /* Simple busy-wait timeout (Phase 1 limitation)
-     * Production implementations should use hardware timers
-     */
-    uint32_t count = timeout_ms * 1000;
-    
-    while (amp_mailbox_try_recv(mbox, msg) != 0) {
-        if (timeout_ms > 0 && --count == 0) {
+    amp_mailbox_prio_t *prio = mailbox_prio(mbox);
+    amp_mailbox_t l = mailbox_lane(mbox, lane);
+
+    (void)amp_atomic_fetch_and(&prio->ready, ~(1u << lane));
+
+    /* A message published before the clear would lose its bit: restore it */
+    if (!mailbox_empty(l)) {
+        (void)amp_atomic_fetch_or(&prio->ready, 1u << lane);
+    }
+}
+
+/**
+ * Try to receive the oldest message of the highest non-empty lane
+ */
+static int mailbox_prio_try_recv(amp_mailbox_t mbox, void *msg)
+{
+    amp_mailbox_prio_t *prio = mailbox_prio(mbox);
+
+    for (;;) {
+        uint32_t ready = amp_atomic_load_acquire(&prio->ready);
+        if (ready == 0) {
             return -1;
         }
+
+        /* Highest set bit is the most urgent lane */
+        uint32_t lane = 31u - (uint32_t)__builtin_clz(ready);
+        amp_mailbox_t l = mailbox_lane(mbox, lane);
+
+        if (mailbox_try_recv(l, msg) == 0) {
+            if (mailbox_empty(l)) {
+                mailbox_prio_clear(mbox, lane);
+            }
+            return 0;
+        }
+
+        mailbox_prio_clear(mbox, lane);
     }
-    
-    return 0;
+}
+
+/**
+ * Wake a sleeping receiver and the mailbox's poll set after publishing
+ */
+static void mailbox_notify_rx(amp_mailbox_t mbox)
+{
+    amp_doorbell_ring(&mbox->rx_bell);
+    amp_poll_link_notify(&mbox->poll);
+}
+
+/**
+ * Try to send one message and wake a sleeping receiver
+ * The lane is ignored for plain mailboxes
+ */
+static int mailbox_send_one(amp_mailbox_t mbox, const void *msg, uint32_t lane)
+{
+    int result = mbox->lanes ? mailbox_prio_try_send(mbox, msg, lane)
+                             : mailbox_try_send(mbox, msg);
+
+    if (result == 0) {
+        mailbox_notify_rx(mbox);
+    }
+
+    return result;
+}
+
+/**
+ * Try to receive one message and wake a sleeping sender
+ */
+static int mailbox_recv_one(amp_mailbox_t mbox, void *msg)
+{
+    int result = mbox->lanes ? mailbox_prio_try_recv(mbox, msg)
+                             : mailbox_try_recv(mbox, msg);
+
+    if (result == 0) {
+        amp_doorbell_ring(&mbox->tx_bell);
+    }
+
+    return result;
+}
+
+/* Blocking single-message operation, see mailbox_send_cond() */
+typedef struct {
+    amp_mailbox_t mbox;
+    void *msg;
+    uint32_t lane;
+} mailbox_wait_t;
+
+/**
+ * Doorbell condition: the message was sent
+ */
+static bool mailbox_send_cond(void *arg)
+{
+    mailbox_wait_t *wait = (mailbox_wait_t *)arg;
+
+    return mailbox_send_one(wait->mbox, wait->msg, wait->lane) == 0;
+}
+
+/**
+ * Doorbell condition: a message was received
+ */
+static bool mailbox_recv_cond(void *arg)
+{
+    mailbox_wait_t *wait = (mailbox_wait_t *)arg;
+
+    return mailbox_recv_one(wait->mbox, wait->msg) == 0;
+}
+
+/**
+ * Try to send a message (non-blocking)
+ */
+int amp_mailbox_try_send(amp_mailbox_t mbox, const void *msg)
+{
+    if (!mbox || !msg) {
+        return -1;
+    }
+
+    /* Plain sends to a priority mailbox use the lowest lane */
+    if (mbox->lanes) {
+        return amp_mailbox_try_send_priority(mbox, msg, 0);
+    }
+
+    return mailbox_send_one(mbox, msg, 0);
+}
+
+/**
+ * Try to receive a message (non-blocking)
+ */
+int amp_mailbox_try_recv(amp_mailbox_t mbox, void *msg)
+{
+    if (!mbox || !msg) {
+        return -1;
+    }
+
+    return mailbox_recv_one(mbox, msg);
+}
+
+/**
+ * Try to send a message to a priority lane (non-blocking)
+ */
+int amp_mailbox_try_send_priority(amp_mailbox_t mbox, const void *msg, uint32_t lane)
+{
+    if (!mbox || !msg || lane >= mbox->lanes) {
+        return -1;
+    }
+
+    if (mailbox_send_one(mbox, msg, lane) != 0) {
+        (void)amp_atomic_fetch_add(&mailbox_prio(mbox)->drops[lane], 1u);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * Send a message to a priority lane (blocking)
+ */
+int amp_mailbox_send_priority(amp_mailbox_t mbox, const void *msg, uint32_t lane,
+                              uint32_t timeout_ms)
+{
+    return amp_mailbox_send_priority_until(mbox, msg, lane, amp_time_deadline_ms(timeout_ms));
+}
+
+/**
+ * Send a message to a priority lane (blocking until an absolute deadline)
+ */
+int amp_mailbox_send_priority_until(amp_mailbox_t mbox, const void *msg, uint32_t lane,
+                                    amp_time_t deadline)
+{
+    if (!mbox || !msg || lane >= mbox->lanes) {
+        return -1;
+    }
+
+    mailbox_wait_t wait = { mbox, (void *)msg, lane };
+    if (amp_doorbell_wait_for(&mbox->tx_bell, mailbox_send_cond, &wait, deadline) != 0) {
+        (void)amp_atomic_fetch_add(&mailbox_prio(mbox)->drops[lane], 1u);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * Get the statistics of a priority lane
+ */
+int amp_mailbox_get_lane_stats(amp_mailbox_t mbox, uint32_t lane,
+                               amp_mailbox_lane_stats_t *stats)
+{
+    if (!mbox || !stats || lane >= mbox->lanes) {
+        return -1;
+    }
+
+    amp_mailbox_t l = mailbox_lane(mbox, lane);
+    stats->depth = amp_atomic_load_relaxed(&l->write_idx) - amp_atomic_load_relaxed(&l->read_idx);
+    stats->drops = amp_atomic_load_relaxed(&mailbox_prio(mbox)->drops[lane]);
+
+    return 0;
+}
+
+/**
+ * Try to send several messages in sequenced or MPSC mode
+ * Claims the run of free slots ahead of the producer, then publishes it
+ */
+static size_t mailbox_seq_try_send_batch(amp_mailbox_t mbox, const char *msgs, size_t n)
+{
+    uint32_t pos;
+
+    if (n > mbox->msg_slots) {
+        n = mbox->msg_slots;
+    }
+
+    uint32_t count = mailbox_seq_claim(mbox, (uint32_t)n, &pos);
+    if (count == 0) {
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        memcpy(mailbox_seq_slot(mbox, pos + i) + 1, msgs + (size_t)i * mbox->msg_size,
+               mbox->msg_size);
+    }
+
+    /* Release: each payload is complete before its slot is published */
+    for (uint32_t i = 0; i < count; i++) {
+        amp_atomic_store_release(&mailbox_seq_slot(mbox, pos + i)->seq, pos + i + 1);
+    }
+
+    return count;
+}
+
+/**
+ * Try to receive several messages in sequenced or MPSC mode
+ * Takes the run of published slots at the consumer, then hands them back
+ */
+static size_t mailbox_seq_try_recv_batch(amp_mailbox_t mbox, char *msgs, size_t max)
+{
+    uint32_t pos = amp_atomic_load_relaxed(&mbox->read_idx);
+    size_t count = 0;
+
+    if (max > mbox->msg_slots) {
+        max = mbox->msg_slots;
+    }
+
+    /* Acquire: no payload is read ahead of its sequence */
+    while (count < max &&
+           amp_atomic_load_acquire(&mailbox_seq_slot(mbox, pos + (uint32_t)count)->seq) ==
+               pos + (uint32_t)count + 1) {
+        count++;
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        memcpy(msgs + i * mbox->msg_size,
+               (amp_mailbox_slot_t *)mailbox_slot(mbox, pos + (uint32_t)i) + 1, mbox->msg_size);
+    }
+
+    /* Release: the payloads are read before the slots go back for the next lap */
+    for (size_t i = 0; i < count; i++) {
+        amp_atomic_store_release(&mailbox_seq_slot(mbox, pos + (uint32_t)i)->seq,
+                                 pos + (uint32_t)i + mbox->msg_slots);
+    }
+    amp_atomic_store_relaxed(&mbox->read_idx, pos + (uint32_t)count);
+
+    return count;
+}
+
+/**
+ * Try to send several messages to a plain mailbox
+ */
+static size_t mailbox_try_send_batch(amp_mailbox_t mbox, const void *msgs, size_t n)
+{
+    if (mailbox_sequenced(mbox)) {
+        return mailbox_seq_try_send_batch(mbox, msgs, n);
+    }
+
+    const char *src = (const char *)msgs;
+    uint32_t write_idx = amp_atomic_load_relaxed(&mbox->write_idx);
+    uint32_t read_idx = amp_atomic_load_acquire(&mbox->read_idx);
+
+    /* Limit to the free slots */
+    size_t free_slots = mbox->msg_slots - (write_idx - read_idx);
+    if (n > free_slots) {
+        n = free_slots;
+    }
+
+    /* Copy messages */
+    for (size_t i = 0; i < n; i++) {
+        memcpy(mailbox_slot(mbox, write_idx + (uint32_t)i), src + i * mbox->msg_size,
+               mbox->msg_size);
+    }
+
+    /* One release index update for the whole batch */
+    amp_atomic_store_release(&mbox->write_idx, write_idx + (uint32_t)n);
+
+    return n;
+}
+
+/**
+ * Try to receive several messages from a plain mailbox
+ */
+static size_t mailbox_try_recv_batch(amp_mailbox_t mbox, void *msgs, size_t max)
+{
+    if (mailbox_sequenced(mbox)) {
+        return mailbox_seq_try_recv_batch(mbox, msgs, max);
+    }
+
+    char *dst = (char *)msgs;
+    uint32_t write_idx = amp_atomic_load_acquire(&mbox->write_idx);
+    uint32_t read_idx = amp_atomic_load_relaxed(&mbox->read_idx);
+
+    /* Limit to the queued messages */
+    size_t queued = write_idx - read_idx;
+    if (max > queued) {
+        max = queued;
+    }
+
+    if (max == 0) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < max; i++) {
+        memcpy(dst + i * mbox->msg_size, mailbox_slot(mbox, read_idx + (uint32_t)i),
+               mbox->msg_size);
+    }
+
+    /* One release index update for the whole batch */
+    amp_atomic_store_release(&mbox->read_idx, read_idx + (uint32_t)max);
+
+    return max;
+}
+
+/**
+ * Try to send several messages (non-blocking)
+ */
+size_t amp_mailbox_try_send_batch(amp_mailbox_t mbox, const void *msgs, size_t n)
+{
+    if (!mbox || !msgs || n == 0 || !mailbox_fixed(mbox)) {
+        return 0;
+    }
+
+    size_t count = mailbox_try_send_batch(mbox, msgs, n);
+    if (count > 0) {
+        mailbox_notify_rx(mbox);
+    }
+
+    return count;
+}
+
+/**
+ * Try to receive several messages (non-blocking)
+ */
+size_t amp_mailbox_try_recv_batch(amp_mailbox_t mbox, void *msgs, size_t max)
+{
+    if (!mbox || !msgs || max == 0 || !mailbox_fixed(mbox)) {
+        return 0;
+    }
+
+    size_t count = mailbox_try_recv_batch(mbox, msgs, max);
+    if (count > 0) {
+        amp_doorbell_ring(&mbox->tx_bell);
+    }
+
+    return count;
+}
+
+/* Blocking batch operation, see mailbox_send_batch_cond() */
+typedef struct {
+    amp_mailbox_t mbox;
+    char *msgs;
+    size_t n;       /* Messages requested */
+    size_t done;    /* Messages transferred so far */
+} mailbox_batch_wait_t;
+
+/**
+ * Doorbell condition: every message of the batch was sent
+ */
+static bool mailbox_send_batch_cond(void *arg)
+{
+    mailbox_batch_wait_t *wait = (mailbox_batch_wait_t *)arg;
+
+    wait->done += amp_mailbox_try_send_batch(wait->mbox,
+                                             wait->msgs + wait->done * wait->mbox->msg_size,
+                                             wait->n - wait->done);
+
+    return wait->done == wait->n;
+}
+
+/**
+ * Doorbell condition: at least one message was received
+ */
+static bool mailbox_recv_batch_cond(void *arg)
+{
+    mailbox_batch_wait_t *wait = (mailbox_batch_wait_t *)arg;
+
+    wait->done = amp_mailbox_try_recv_batch(wait->mbox, wait->msgs, wait->n);
+
+    return wait->done > 0;
+}
+
+/**
+ * Lease the next free slot for building a message in place
+ */
+void *amp_mailbox_acquire_tx_slot(amp_mailbox_t mbox)
+{
+    if (!mbox || !mailbox_fixed(mbox) || mbox->mode == AMP_MAILBOX_MODE_MPSC) {
+        return NULL;
+    }
+
+    uint32_t write_idx = amp_atomic_load_relaxed(&mbox->write_idx);
+
+    /* Acquire: the payload is not written before the check */
+    if (mbox->mode == AMP_MAILBOX_MODE_SEQUENCED) {
+        amp_mailbox_slot_t *slot = (amp_mailbox_slot_t *)mailbox_slot(mbox, write_idx);
+        if (amp_atomic_load_acquire(&slot->seq) != write_idx) {
+            return NULL;
+        }
+
+        return slot + 1;
+    }
+
+    /* Check if mailbox is full */
+    if (write_idx - amp_atomic_load_acquire(&mbox->read_idx) >= mbox->msg_slots) {
+        return NULL;
+    }
+
+    return mailbox_slot(mbox, write_idx);
+}
+
+/**
+ * Publish the leased transmit slot
+ */
+int amp_mailbox_commit_tx(amp_mailbox_t mbox)
+{
+    if (!mbox || !mailbox_fixed(mbox) || mbox->mode == AMP_MAILBOX_MODE_MPSC) {
+        return -1;
+    }
+
+    uint32_t write_idx = amp_atomic_load_relaxed(&mbox->write_idx);
+
+    if (mbox->mode == AMP_MAILBOX_MODE_SEQUENCED) {
+        amp_mailbox_slot_t *slot = (amp_mailbox_slot_t *)mailbox_slot(mbox, write_idx);
+        if (amp_atomic_load_acquire(&slot->seq) != write_idx) {
+            return -1;
+        }
+
+        /* Release: the payload is complete before the slot is published */
+        amp_atomic_store_release(&slot->seq, write_idx + 1);
+        amp_atomic_store_relaxed(&mbox->write_idx, write_idx + 1);
+    } else {
+        if (write_idx - amp_atomic_load_acquire(&mbox->read_idx) >= mbox->msg_slots) {
+            return -1;
+        }
+
+        /* Release: the message is complete before the write index covers it */
+        amp_atomic_store_release(&mbox->write_idx, write_idx + 1);
+    }
+
+    mailbox_notify_rx(mbox);
+
+    return 0;
+}
+
+/**
+ * Lease the oldest queued message for reading in place
+ */
+const void *amp_mailbox_acquire_rx_slot(amp_mailbox_t mbox)
+{
+    if (!mbox || !mailbox_fixed(mbox)) {
+        return NULL;
+    }
+
+    uint32_t read_idx = amp_atomic_load_relaxed(&mbox->read_idx);
+
+    /* Acquire: the payload is not read ahead of the sequence or write index */
+    if (mailbox_sequenced(mbox)) {
+        amp_mailbox_slot_t *slot = (amp_mailbox_slot_t *)mailbox_slot(mbox, read_idx);
+        if (amp_atomic_load_acquire(&slot->seq) != read_idx + 1) {
+            return NULL;
+        }
+
+        return slot + 1;
+    }
+
+    /* Check if mailbox is empty */
+    if (read_idx == amp_atomic_load_acquire(&mbox->write_idx)) {
+        return NULL;
+    }
+
+    return mailbox_slot(mbox, read_idx);
+}
+
+/**
+ * Return the leased receive slot to the producer
+ */
+int amp_mailbox_release_rx(amp_mailbox_t mbox)
+{
+    if (!mbox || !mailbox_fixed(mbox)) {
+        return -1;
+    }
+
+    uint32_t read_idx = amp_atomic_load_relaxed(&mbox->read_idx);
+
+    if (mailbox_sequenced(mbox)) {
+        amp_mailbox_slot_t *slot = (amp_mailbox_slot_t *)mailbox_slot(mbox, read_idx);
+        if (amp_atomic_load_relaxed(&slot->seq) != read_idx + 1) {
+            return -1;
+        }
+
+        /* Release: the payload is read before the slot goes back for the next lap */
+        amp_atomic_store_release(&slot->seq, read_idx + mbox->msg_slots);
+        amp_atomic_store_relaxed(&mbox->read_idx, read_idx + 1);
+    } else {
+        if (read_idx == amp_atomic_load_relaxed(&mbox->write_idx)) {
+            return -1;
+        }
+
+        /* Release: the message is read before its slot is handed back */
+        amp_atomic_store_release(&mbox->read_idx, read_idx + 1);
+    }
+
+    amp_doorbell_ring(&mbox->tx_bell);
+
+    return 0;
+}
+
+/**
+ * Get the poll set link of a mailbox
+ */
+amp_poll_link_t *amp_mailbox_poll_link(amp_mailbox_t mbox)
+{
+    return &mbox->poll;
+}
+
+/**
+ * Check whether a mailbox holds a published message
+ */
+bool amp_mailbox_poll_ready(amp_mailbox_t mbox)
+{
+    if (!mbox->lanes) {
+        return !mailbox_empty(mbox);
+    }
+
+    uint32_t ready = amp_atomic_load_acquire(&mailbox_prio(mbox)->ready);
+    while (ready != 0) {
+        uint32_t lane = (uint32_t)__builtin_ctz(ready);
+        if (!mailbox_empty(mailbox_lane(mbox, lane))) {
+            return true;
+        }
+        ready &= ready - 1u;
+    }
+
+    return false;
+}
+
+/**
+ * Send a message (blocking)
+ */
+int amp_mailbox_send(amp_mailbox_t mbox, const void *msg, uint32_t timeout_ms)
+{
+    return amp_mailbox_send_until(mbox, msg, amp_time_deadline_ms(timeout_ms));
+}
+
+/**
+ * Receive a message (blocking)
+ */
+int amp_mailbox_recv(amp_mailbox_t mbox, void *msg, uint32_t timeout_ms)
+{
+    return amp_mailbox_recv_until(mbox, msg, amp_time_deadline_ms(timeout_ms));
+}
+
+/**
+ * Send a message (blocking until an absolute deadline)
+ */
+int amp_mailbox_send_until(amp_mailbox_t mbox, const void *msg, amp_time_t deadline)
+{
+    if (!mbox || !msg) {
+        return -1;
+    }
+
+    if (mbox->lanes) {
+        return amp_mailbox_send_priority_until(mbox, msg, 0, deadline);
+    }
+
+    mailbox_wait_t wait = { mbox, (void *)msg, 0 };
+
+    return amp_doorbell_wait_for(&mbox->tx_bell, mailbox_send_cond, &wait, deadline);
+}
+
+/**
+ * Receive a message (blocking until an absolute deadline)
+ */
+int amp_mailbox_recv_until(amp_mailbox_t mbox, void *msg, amp_time_t deadline)
+{
+    if (!mbox || !msg) {
+        return -1;
+    }
+
+    mailbox_wait_t wait = { mbox, msg, 0 };
+
+    return amp_doorbell_wait_for(&mbox->rx_bell, mailbox_recv_cond, &wait, deadline);
+}
+
+/**
+ * Send several messages (blocking)
+ */
+size_t amp_mailbox_send_batch(amp_mailbox_t mbox, const void *msgs, size_t n,
+                              uint32_t timeout_ms)
+{
+    return amp_mailbox_send_batch_until(mbox, msgs, n, amp_time_deadline_ms(timeout_ms));
+}
+
+/**
+ * Receive several messages (blocking)
+ */
+size_t amp_mailbox_recv_batch(amp_mailbox_t mbox, void *msgs, size_t max,
+                              uint32_t timeout_ms)
+{
+    return amp_mailbox_recv_batch_until(mbox, msgs, max, amp_time_deadline_ms(timeout_ms));
+}
+
+/**
+ * Send several messages (blocking until an absolute deadline)
+ */
+size_t amp_mailbox_send_batch_until(amp_mailbox_t mbox, const void *msgs, size_t n,
+                                    amp_time_t deadline)
+{
+    if (!mbox || !msgs || !mailbox_fixed(mbox)) {
+        return 0;
+    }
+
+    mailbox_batch_wait_t wait = { mbox, (char *)msgs, n, 0 };
+    (void)amp_doorbell_wait_for(&mbox->tx_bell, mailbox_send_batch_cond, &wait, deadline);
+
+    return wait.done;
+}
+
+/**
+ * Receive several messages (blocking until an absolute deadline)
+ */
+size_t amp_mailbox_recv_batch_until(amp_mailbox_t mbox, void *msgs, size_t max,
+                                    amp_time_t deadline)
+{
+    if (!mbox || !msgs || max == 0 || !mailbox_fixed(mbox)) {
+        return 0;
+    }
+
+    mailbox_batch_wait_t wait = { mbox, msgs, max, 0 };
+    (void)amp_doorbell_wait_for(&mbox->rx_bell, mailbox_recv_batch_cond, &wait, deadline);
+
+    return wait.done;
+}
+
+/**
+ * Try to send one variable-length message and wake a sleeping receiver
+ */
+static int mailbox_send_var_one(amp_mailbox_t mbox, const void *msg, uint32_t len)
+{
+    int result = mailbox_var_try_send(mbox, msg, len);
+
+    if (result == 0) {
+        mailbox_notify_rx(mbox);
+    }
+
+    return result;
+}
+
+/**
+ * Try to receive one variable-length message and wake a sleeping sender
+ */
+static int mailbox_recv_var_one(amp_mailbox_t mbox, void *msg, uint32_t *len)
+{
+    int result = mailbox_var_try_recv(mbox, msg, len);
+
+    if (result == 0) {
+        amp_doorbell_ring(&mbox->tx_bell);
+    }
+
+    return result;
+}
+
+/* Blocking variable-length operation, see mailbox_send_var_cond() */
+typedef struct {
+    amp_mailbox_t mbox;
+    void *msg;
+    uint32_t len;       /* Payload length to send */
+    uint32_t *len_out;  /* Filled with the received payload length */
+} mailbox_var_wait_t;
+
+/**
+ * Doorbell condition: the variable-length message was sent
+ */
+static bool mailbox_send_var_cond(void *arg)
+{
+    mailbox_var_wait_t *wait = (mailbox_var_wait_t *)arg;
+
+    return mailbox_send_var_one(wait->mbox, wait->msg, wait->len) == 0;
+}
+
+/**
+ * Doorbell condition: a variable-length message was received
+ */
+static bool mailbox_recv_var_cond(void *arg)
+{
+    mailbox_var_wait_t *wait = (mailbox_var_wait_t *)arg;
+
+    return mailbox_recv_var_one(wait->mbox, wait->msg, wait->len_out) == 0;
+}
+
+/**
+ * Try to send a variable-length message (non-blocking)
+ */
+int amp_mailbox_try_send_var(amp_mailbox_t mbox, const void *msg, uint32_t len)
+{
+    if (!mbox || !msg || mbox->mode != AMP_MAILBOX_MODE_VARIABLE || len > mbox->msg_size) {
+        return -1;
+    }
+
+    return mailbox_send_var_one(mbox, msg, len);
+}
+
+/**
+ * Try to receive a variable-length message (non-blocking)
+ */
+int amp_mailbox_try_recv_var(amp_mailbox_t mbox, void *msg, uint32_t max_len, uint32_t *len)
+{
+    if (!mbox || !msg || !len || mbox->mode != AMP_MAILBOX_MODE_VARIABLE ||
+        max_len < mbox->msg_size) {
+        return -1;
+    }
+
+    return mailbox_recv_var_one(mbox, msg, len);
+}
+
+/**
+ * Send a variable-length message (blocking)
+ */
+int amp_mailbox_send_var(amp_mailbox_t mbox, const void *msg, uint32_t len,
+                         uint32_t timeout_ms)
+{
+    return amp_mailbox_send_var_until(mbox, msg, len, amp_time_deadline_ms(timeout_ms));
+}
+
+/**
+ * Receive a variable-length message (blocking)
+ */
+int amp_mailbox_recv_var(amp_mailbox_t mbox, void *msg, uint32_t max_len, uint32_t *len,
+                         uint32_t timeout_ms)
+{
+    return amp_mailbox_recv_var_until(mbox, msg, max_len, len,
+                                      amp_time_deadline_ms(timeout_ms));
+}
+
+/**
+ * Send a variable-length message (blocking until an absolute deadline)
+ */
+int amp_mailbox_send_var_until(amp_mailbox_t mbox, const void *msg, uint32_t len,
+                               amp_time_t deadline)
+{
+    if (!mbox || !msg || mbox->mode != AMP_MAILBOX_MODE_VARIABLE || len > mbox->msg_size) {
+        return -1;
+    }
+
+    mailbox_var_wait_t wait = { mbox, (void *)msg, len, NULL };
+
+    return amp_doorbell_wait_for(&mbox->tx_bell, mailbox_send_var_cond, &wait, deadline);
+}
+
+/**
+ * Receive a variable-length message (blocking until an absolute deadline)
+ */
+int amp_mailbox_recv_var_until(amp_mailbox_t mbox, void *msg, uint32_t max_len, uint32_t *len,
+                               amp_time_t deadline)
+{
+    if (!mbox || !msg || !len || mbox->mode != AMP_MAILBOX_MODE_VARIABLE ||
+        max_len < mbox->msg_size) {
+        return -1;
+    }
+
+    mailbox_var_wait_t wait = { mbox, msg, 0, len };
+
+    return amp_doorbell_wait_for(&mbox->rx_bell, mailbox_recv_var_cond, &wait, deadline);
 }
@@ -0,0 +1,218 @@
+/**
+ * @file amp_poll.c
+ * @brief Readiness Polling Implementation
+ */
+
+#include "amp_poll.h"
+#include "amp_poll_internal.h"
+#include "amp_shmem.h"
+#include "amp_atomic.h"
+#include "amp_doorbell_internal.h"
+#include "amp_layout.h"
+
+/* Poll set structure in shared memory
+ * A bit in ready means its object may be ready; the poller confirms it
+ * against the object and clears bits that turn out stale
+ */
+struct amp_poll_set_s {
+    AMP_LAYOUT_LINE amp_atomic_u32_t ready;     /* Set by producers, cleared by the poller */
+    struct amp_doorbell_s bell;     /* Rung by producers after setting a bit */
+    AMP_LAYOUT_LINE uint32_t count;                 /* Configuration */
+    amp_poll_item_t items[AMP_POLL_MAX_ITEMS];
+};
+
+/**
+ * Get the poll set link of an item
+ */
+static amp_poll_link_t *poll_item_link(const amp_poll_item_t *item)
+{
+    if (!item->handle) {
+        return NULL;
+    }
+
+    switch (item->type) {
+    case AMP_POLL_MAILBOX:
+        return amp_mailbox_poll_link((amp_mailbox_t)item->handle);
+    case AMP_POLL_RINGBUF:
+        return amp_ringbuf_poll_link((amp_ringbuf_t)item->handle);
+    case AMP_POLL_SEMAPHORE:
+        return amp_semaphore_poll_link((amp_semaphore_t)item->handle);
+    default:
+        return NULL;
+    }
+}
+
+/**
+ * Check whether an item is ready
+ */
+static bool poll_item_ready(const amp_poll_item_t *item)
+{
+    switch (item->type) {
+    case AMP_POLL_MAILBOX:
+        return amp_mailbox_poll_ready((amp_mailbox_t)item->handle);
+    case AMP_POLL_RINGBUF:
+        return amp_ringbuf_available((amp_ringbuf_t)item->handle) > 0;
+    case AMP_POLL_SEMAPHORE:
+        return amp_semaphore_get_count((amp_semaphore_t)item->handle) > 0;
+    default:
+        return false;
+    }
+}
+
+/**
+ * Create a poll set
+ */
+amp_poll_set_t amp_poll_set_create(const amp_poll_item_t *items, uint32_t n)
+{
+    if (!items || n == 0 || n > AMP_POLL_MAX_ITEMS) {
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+        amp_poll_link_t *link = poll_item_link(&items[i]);
+        if (!link || amp_atomic_load_ptr_relaxed(&link->set)) {
+            return NULL;
+        }
+    }
+
+    struct amp_poll_set_s *set = amp_shmem_alloc_aligned(sizeof(struct amp_poll_set_s),
+                                                         AMP_LAYOUT_ALIGN);
+    if (!set) {
+        return NULL;
+    }
+
+    /* Every object starts flagged, so the first poll checks each one */
+    amp_atomic_store_relaxed(&set->ready, (n == 32u) ? 0xFFFFFFFFu : (1u << n) - 1u);
+    set->count = n;
+    amp_doorbell_init(&set->bell);
+    for (uint32_t i = 0; i < n; i++) {
+        set->items[i] = items[i];
+        poll_item_link(&items[i])->mask = 1u << i;
+    }
+
+    /* Release so producers see the set before they can reach it */
+    for (uint32_t i = 0; i < n; i++) {
+        amp_atomic_store_ptr_release(&poll_item_link(&items[i])->set, set);
+    }
+
+    return set;
+}
+
+/**
+ * Destroy a poll set
+ */
+void amp_poll_set_destroy(amp_poll_set_t set)
+{
+    if (!set) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < set->count; i++) {
+        amp_atomic_store_ptr_release(&poll_item_link(&set->items[i])->set, NULL);
+    }
+
+    /* Simple allocator doesn't support individual frees */
+}
+
+/**
+ * Mark an object ready and wake the poller
+ */
+void amp_poll_set_notify(struct amp_poll_set_s *set, uint32_t mask)
+{
+    /* Pairs with the poller's fence after clearing a stale bit: either it
+     * sees the published object, or this sees the bit cleared
+     */
+    amp_atomic_fence_seq_cst();
+
+    /* Skip the atomic while the bit is still set from an earlier publish */
+    if ((amp_atomic_load_relaxed(&set->ready) & mask) == 0) {
+        (void)amp_atomic_fetch_or(&set->ready, mask);
+    }
+
+    amp_doorbell_ring(&set->bell);
+}
+
+/**
+ * Confirm the flagged objects and collect the ready ones
+ * Only objects whose bit is set are touched
+ */
+static uint32_t poll_ready(amp_poll_set_t set)
+{
+    uint32_t pending = amp_atomic_load_acquire(&set->ready);
+    uint32_t result = 0;
+
+    while (pending != 0) {
+        uint32_t bit = (uint32_t)__builtin_ctz(pending);
+        uint32_t mask = 1u << bit;
+        pending &= pending - 1u;
+
+        if (poll_item_ready(&set->items[bit])) {
+            result |= mask;
+            continue;
+        }
+
+        (void)amp_atomic_fetch_and(&set->ready, ~mask);
+        amp_atomic_fence_seq_cst();
+
+        /* A publish before the clear would lose its bit: restore it */
+        if (poll_item_ready(&set->items[bit])) {
+            (void)amp_atomic_fetch_or(&set->ready, mask);
+            result |= mask;
+        }
+    }
+
+    return result;
+}
+
+/* Blocking poll, see poll_cond() */
+typedef struct {
+    amp_poll_set_t set;
+    uint32_t result;
+} poll_wait_t;
+
+/**
+ * Doorbell condition: at least one object is ready
+ */
+static bool poll_cond(void *arg)
+{
+    poll_wait_t *wait = (poll_wait_t *)arg;
+
+    wait->result = poll_ready(wait->set);
+
+    return wait->result != 0;
+}
+
+/**
+ * Check which objects are ready (non-blocking)
+ */
+uint32_t amp_poll_try(amp_poll_set_t set)
+{
+    if (!set) {
+        return 0;
+    }
+
+    return poll_ready(set);
+}
+
+/**
+ * Wait until at least one object is ready (blocking)
+ */
+uint32_t amp_poll(amp_poll_set_t set, uint32_t timeout_ms)
+{
+    return amp_poll_until(set, amp_time_deadline_ms(timeout_ms));
+}
+
+/**
+ * Wait until at least one object is ready (blocking until an absolute deadline)
+ */
+uint32_t amp_poll_until(amp_poll_set_t set, amp_time_t deadline)
+{
+    if (!set) {
+        return 0;
+    }
+
+    poll_wait_t wait = { set, 0 };
+    (void)amp_doorbell_wait_for(&set->bell, poll_cond, &wait, deadline);
+
+    return wait.result;
+}
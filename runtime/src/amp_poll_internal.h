@@ -0,0 +1,88 @@
+/**
+ * @file amp_poll_internal.h
+ * @brief Poll Set Links for Embedding in IPC Control Blocks
+ *
+ * Every pollable object embeds a link that names the poll set it belongs
+ * to and its bit in the set's readiness word. Producers notify the link
+ * after publishing.
+ */
+
+#ifndef AMP_POLL_INTERNAL_H
+#define AMP_POLL_INTERNAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "amp_atomic.h"
+#include "amp_poll.h"
+#include "amp_mailbox.h"
+#include "amp_ringbuf.h"
+#include "amp_semaphore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Poll set link in shared memory
+ * Written when the object joins or leaves a set, read on every publish
+ */
+typedef struct {
+    amp_atomic_ptr_t set;   /* struct amp_poll_set_s, NULL while not polled */
+    uint32_t mask;          /* Object's bit in the set */
+} amp_poll_link_t;
+
+/**
+ * Mark an object ready and wake the poller
+ * Call after publishing; fences before it tests the object's bit
+ *
+ * @param set Poll set
+ * @param mask Object's bit in the set
+ */
+void amp_poll_set_notify(struct amp_poll_set_s *set, uint32_t mask);
+
+/**
+ * Initialize an embedded poll set link
+ */
+static inline void amp_poll_link_init(amp_poll_link_t *link)
+{
+    amp_atomic_store_ptr_relaxed(&link->set, NULL);
+    link->mask = 0;
+}
+
+/**
+ * Notify the poll set an object belongs to, if any
+ * Costs one load while the object is not polled
+ */
+static inline void amp_poll_link_notify(amp_poll_link_t *link)
+{
+    struct amp_poll_set_s *set = amp_atomic_load_ptr_acquire(&link->set);
+
+    if (set) {
+        amp_poll_set_notify(set, link->mask);
+    }
+}
+
+/**
+ * Get the poll set link of a mailbox
+ */
+amp_poll_link_t *amp_mailbox_poll_link(amp_mailbox_t mbox);
+
+/**
+ * Check whether a mailbox holds a published message
+ */
+bool amp_mailbox_poll_ready(amp_mailbox_t mbox);
+
+/**
+ * Get the poll set link of a ring buffer
+ */
+amp_poll_link_t *amp_ringbuf_poll_link(amp_ringbuf_t rb);
+
+/**
+ * Get the poll set link of a semaphore
+ */
+amp_poll_link_t *amp_semaphore_poll_link(amp_semaphore_t sem);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMP_POLL_INTERNAL_H */
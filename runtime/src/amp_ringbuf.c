@@ -5,16 +5,30 @@
 
 #include "amp_ringbuf.h"
 #include "amp_shmem.h"
-#include "amp_barriers.h"
+#include "amp_atomic.h"
+#include "amp_copy.h"
+#include "amp_doorbell_internal.h"
+#include "amp_layout.h"
+#include "amp_poll_internal.h"
 #include <string.h>
 
-/* Ring buffer structure in shared memory */
+/* Ring buffer structure in shared memory
+ * Producer-owned, consumer-owned and immutable fields are grouped so that
+ * AMP_LAYOUT_PADDED can put each group on its own cache line. Each side
+ * keeps a shadow copy of the other side's index next to its own and only
+ * re-reads the shared one when the shadow says the ring is full or empty.
+ */
 struct amp_ringbuf_s {
-    volatile uint32_t write_idx;
-    volatile uint32_t read_idx;
-    uint32_t size;
+    AMP_LAYOUT_LINE amp_atomic_u32_t write_idx;     /* Producer */
+    uint32_t read_idx_shadow;   /* Producer's last seen read_idx */
+    AMP_LAYOUT_LINE amp_atomic_u32_t read_idx;      /* Consumer */
+    uint32_t write_idx_shadow;  /* Consumer's last seen write_idx */
+    struct amp_doorbell_s rx_bell;  /* Rung by the producer after publishing */
+    struct amp_doorbell_s tx_bell;  /* Rung by the consumer after freeing space */
+    AMP_LAYOUT_LINE uint32_t size;                  /* Configuration */
     uint32_t mask;  /* size - 1, for fast modulo */
-    char data[];    /* Buffer data follows */
+    amp_poll_link_t poll;   /* Poll set notified after publishing */
+    AMP_LAYOUT_LINE char data[];    /* Buffer data follows */
 };
 
 /**
@@ -28,14 +42,19 @@ amp_ringbuf_t amp_ringbuf_create(size_t size)
     }
 
     size_t total_size = sizeof(struct amp_ringbuf_s) + size;
-    struct amp_ringbuf_s *rb = amp_shmem_alloc(total_size);
+    struct amp_ringbuf_s *rb = amp_shmem_alloc_aligned(total_size, AMP_LAYOUT_ALIGN);
     
     if (!rb) {
         return NULL;
     }
 
-    rb->write_idx = 0;
-    rb->read_idx = 0;
+    amp_atomic_store_relaxed(&rb->write_idx, 0);
+    amp_atomic_store_relaxed(&rb->read_idx, 0);
+    rb->read_idx_shadow = 0;
+    rb->write_idx_shadow = 0;
+    amp_doorbell_init(&rb->rx_bell);
+    amp_doorbell_init(&rb->tx_bell);
+    amp_poll_link_init(&rb->poll);
     rb->size = (uint32_t)size;
     rb->mask = (uint32_t)(size - 1);
 
@@ -51,6 +70,18 @@ void amp_ringbuf_destroy(amp_ringbuf_t rb)
     (void)rb;
 }
 
+/**
+ * Set how blocking calls on the ring buffer wait
+ */
+int amp_ringbuf_set_wait_policy(amp_ringbuf_t rb, amp_wait_policy_t policy)
+{
+    if (!rb || amp_doorbell_set_policy(&rb->rx_bell, policy) != 0) {
+        return -1;
+    }
+
+    return amp_doorbell_set_policy(&rb->tx_bell, policy);
+}
+
 /**
  * Get available bytes to read
  */
@@ -60,8 +91,8 @@ size_t amp_ringbuf_available(amp_ringbuf_t rb)
         return 0;
     }
 
-    uint32_t write_idx = rb->write_idx;
-    uint32_t read_idx = rb->read_idx;
+    uint32_t write_idx = amp_atomic_load_acquire(&rb->write_idx);
+    uint32_t read_idx = amp_atomic_load_acquire(&rb->read_idx);
     
     /* Unsigned subtraction handles wraparound correctly
      * Works because indices are never more than buffer size apart
@@ -82,6 +113,62 @@ size_t amp_ringbuf_free_space(amp_ringbuf_t rb)
     return rb->size - amp_ringbuf_available(rb);
 }
 
+/**
+ * Get free space as seen by the producer
+ * Only reads the consumer's index when the shadow copy shows less than len.
+ * Acquire: space is not overwritten before the consumer has read it; the
+ * shadow only holds values that were loaded that way
+ */
+static size_t ringbuf_producer_space(amp_ringbuf_t rb, size_t len)
+{
+    uint32_t write_idx = amp_atomic_load_relaxed(&rb->write_idx);
+    size_t free_space = rb->size - (size_t)(write_idx - rb->read_idx_shadow);
+
+    if (free_space < len) {
+        rb->read_idx_shadow = amp_atomic_load_acquire(&rb->read_idx);
+        free_space = rb->size - (size_t)(write_idx - rb->read_idx_shadow);
+    }
+
+    return free_space;
+}
+
+/**
+ * Get available bytes as seen by the consumer
+ * Only reads the producer's index when the shadow copy shows less than len.
+ * Acquire: the data is not read ahead of the write index
+ */
+static size_t ringbuf_consumer_available(amp_ringbuf_t rb, size_t len)
+{
+    uint32_t read_idx = amp_atomic_load_relaxed(&rb->read_idx);
+    size_t available = (size_t)(rb->write_idx_shadow - read_idx);
+
+    if (available < len) {
+        rb->write_idx_shadow = amp_atomic_load_acquire(&rb->write_idx);
+        available = (size_t)(rb->write_idx_shadow - read_idx);
+    }
+
+    return available;
+}
+
+/**
+ * Split len bytes starting at index idx into at most two contiguous spans
+ */
+static void ringbuf_spans(amp_ringbuf_t rb, uint32_t idx, size_t len,
+                          amp_ringbuf_span_t *span1, amp_ringbuf_span_t *span2)
+{
+    uint32_t offset = idx & rb->mask;
+    size_t first = rb->size - offset;
+
+    if (first > len) {
+        first = len;
+    }
+
+    span1->data = len ? &rb->data[offset] : NULL;
+    span1->len = first;
+    span2->data = (len > first) ? rb->data : NULL;
+    span2->len = len - first;
+}
+
 /**
  * Write data to ring buffer
  */
@@ -91,21 +178,24 @@ size_t amp_ringbuf_write(amp_ringbuf_t rb, const void *data, size_t len)
         return 0;
     }
 
-    size_t free_space = amp_ringbuf_free_space(rb);
+    size_t free_space = ringbuf_producer_space(rb, len);
     if (len > free_space) {
         len = free_space;
     }
 
     const char *src = (const char *)data;
-    uint32_t write_idx = rb->write_idx;
+    uint32_t write_idx = amp_atomic_load_relaxed(&rb->write_idx);
     
-    for (size_t i = 0; i < len; i++) {
-        rb->data[(write_idx + i) & rb->mask] = src[i];
-    }
+    /* At most two contiguous copies: up to the end, then the wrap */
+    amp_ringbuf_span_t span1, span2;
+    ringbuf_spans(rb, write_idx, len, &span1, &span2);
+    amp_copy(span1.data, src, span1.len);
+    amp_copy(span2.data, src + span1.len, span2.len);
 
-    /* Memory barrier before updating write index */
-    AMP_DMB();
-    rb->write_idx = write_idx + (uint32_t)len;
+    /* Release: the data is complete before the write index covers it */
+    amp_atomic_store_release(&rb->write_idx, write_idx + (uint32_t)len);
+    amp_doorbell_ring(&rb->rx_bell);
+    amp_poll_link_notify(&rb->poll);
 
     return len;
 }
@@ -119,25 +209,102 @@ size_t amp_ringbuf_read(amp_ringbuf_t rb, void *data, size_t len)
         return 0;
     }
 
-    size_t available = amp_ringbuf_available(rb);
+    size_t available = ringbuf_consumer_available(rb, len);
     if (len > available) {
         len = available;
     }
 
     char *dst = (char *)data;
-    uint32_t read_idx = rb->read_idx;
+    uint32_t read_idx = amp_atomic_load_relaxed(&rb->read_idx);
     
-    for (size_t i = 0; i < len; i++) {
-        dst[i] = rb->data[(read_idx + i) & rb->mask];
+    /* At most two contiguous copies: up to the end, then the wrap */
+    amp_ringbuf_span_t span1, span2;
+    ringbuf_spans(rb, read_idx, len, &span1, &span2);
+    amp_copy(dst, span1.data, span1.len);
+    amp_copy(dst + span1.len, span2.data, span2.len);
+
+    /* Release: the data is read before its space is handed back */
+    amp_atomic_store_release(&rb->read_idx, read_idx + (uint32_t)len);
+    amp_doorbell_ring(&rb->tx_bell);
+
+    return len;
+}
+
+/**
+ * Reserve space for writing in place
+ */
+size_t amp_ringbuf_write_reserve(amp_ringbuf_t rb, size_t len,
+                                 amp_ringbuf_span_t *span1, amp_ringbuf_span_t *span2)
+{
+    if (!rb || !span1 || !span2) {
+        return 0;
+    }
+
+    size_t free_space = ringbuf_producer_space(rb, len);
+    if (len > free_space) {
+        len = free_space;
+    }
+
+    ringbuf_spans(rb, amp_atomic_load_relaxed(&rb->write_idx), len, span1, span2);
+
+    return len;
+}
+
+/**
+ * Publish bytes written into reserved spans
+ */
+int amp_ringbuf_write_commit(amp_ringbuf_t rb, size_t len)
+{
+    if (!rb || len > ringbuf_producer_space(rb, len)) {
+        return -1;
+    }
+
+    /* Release: the data is complete before the write index covers it */
+    uint32_t write_idx = amp_atomic_load_relaxed(&rb->write_idx);
+    amp_atomic_store_release(&rb->write_idx, write_idx + (uint32_t)len);
+    amp_doorbell_ring(&rb->rx_bell);
+    amp_poll_link_notify(&rb->poll);
+
+    return 0;
+}
+
+/**
+ * Access readable data in place
+ */
+size_t amp_ringbuf_read_peek(amp_ringbuf_t rb, size_t len,
+                             amp_ringbuf_span_t *span1, amp_ringbuf_span_t *span2)
+{
+    if (!rb || !span1 || !span2) {
+        return 0;
+    }
+
+    size_t available = ringbuf_consumer_available(rb, len);
+    if (len > available) {
+        len = available;
     }
 
-    /* Memory barrier before updating read index */
-    AMP_DMB();
-    rb->read_idx = read_idx + (uint32_t)len;
+    ringbuf_spans(rb, amp_atomic_load_relaxed(&rb->read_idx), len, span1, span2);
 
     return len;
 }
 
+/**
+ * Release bytes consumed from peeked spans
+ */
+int amp_ringbuf_read_release(amp_ringbuf_t rb, size_t len)
+{
+    if (!rb || len > ringbuf_consumer_available(rb, len)) {
+        return -1;
+    }
+
+    /* Release: the data is read before its space is handed back */
+    uint32_t read_idx = amp_atomic_load_relaxed(&rb->read_idx);
+    amp_atomic_store_release(&rb->read_idx, read_idx + (uint32_t)len);
+    amp_doorbell_ring(&rb->tx_bell);
+
+    return 0;
+}
+
 /**
  * Clear all data from buffer
  */
@@ -147,6 +314,85 @@ void amp_ringbuf_clear(amp_ringbuf_t rb)
         return;
     }
 
-    rb->read_idx = rb->write_idx;
-    AMP_DMB();
+    rb->write_idx_shadow = amp_atomic_load_acquire(&rb->write_idx);
+    amp_atomic_store_release(&rb->read_idx, rb->write_idx_shadow);
+    amp_doorbell_ring(&rb->tx_bell);
+}
+
+/* Blocking wait for data or space, see ringbuf_available_cond() */
+typedef struct {
+    amp_ringbuf_t rb;
+    size_t len;
+} ringbuf_wait_t;
+
+/**
+ * Doorbell condition: enough data to read
+ */
+static bool ringbuf_available_cond(void *arg)
+{
+    ringbuf_wait_t *wait = (ringbuf_wait_t *)arg;
+
+    return ringbuf_consumer_available(wait->rb, wait->len) >= wait->len;
+}
+
+/**
+ * Doorbell condition: enough space to write
+ */
+static bool ringbuf_space_cond(void *arg)
+{
+    ringbuf_wait_t *wait = (ringbuf_wait_t *)arg;
+
+    return ringbuf_producer_space(wait->rb, wait->len) >= wait->len;
+}
+
+/**
+ * Wait until enough data is available (blocking)
+ */
+int amp_ringbuf_wait_available(amp_ringbuf_t rb, size_t len, uint32_t timeout_ms)
+{
+    return amp_ringbuf_wait_available_until(rb, len, amp_time_deadline_ms(timeout_ms));
+}
+
+/**
+ * Wait until enough data is available (blocking until an absolute deadline)
+ */
+int amp_ringbuf_wait_available_until(amp_ringbuf_t rb, size_t len, amp_time_t deadline)
+{
+    if (!rb || len > rb->size) {
+        return -1;
+    }
+
+    ringbuf_wait_t wait = { rb, len };
+
+    return amp_doorbell_wait_for(&rb->rx_bell, ringbuf_available_cond, &wait, deadline);
+}
+
+/**
+ * Wait until enough space is free (blocking)
+ */
+int amp_ringbuf_wait_space(amp_ringbuf_t rb, size_t len, uint32_t timeout_ms)
+{
+    return amp_ringbuf_wait_space_until(rb, len, amp_time_deadline_ms(timeout_ms));
+}
+
+/**
+ * Wait until enough space is free (blocking until an absolute deadline)
+ */
+int amp_ringbuf_wait_space_until(amp_ringbuf_t rb, size_t len, amp_time_t deadline)
+{
+    if (!rb || len > rb->size) {
+        return -1;
+    }
+
+    ringbuf_wait_t wait = { rb, len };
+
+    return amp_doorbell_wait_for(&rb->tx_bell, ringbuf_space_cond, &wait, deadline);
+}
+
+/**
+ * Get the poll set link of a ring buffer
+ */
+amp_poll_link_t *amp_ringbuf_poll_link(amp_ringbuf_t rb)
+{
+    return &rb->poll;
 }
@@ -0,0 +1,501 @@
+/**
+ * @file amp_rpc.c
+ * @brief Pipelined Remote Procedure Call Implementation
+ */
+
+#include "amp_rpc.h"
+#include "amp_mailbox.h"
+#include "amp_shmem.h"
+#include "amp_copy.h"
+#include "amp_layout.h"
+
+/* Largest payload accepted by amp_rpc_create() */
+#define RPC_MAX_PAYLOAD (64u * 1024u)
+
+/* Call IDs carry the window slot in their low bits */
+#define RPC_SLOT_BITS 6u
+#define RPC_SLOT_MASK ((1u << RPC_SLOT_BITS) - 1u)
+
+/* Call states */
+#define RPC_CALL_FREE 0u
+#define RPC_CALL_PENDING 1u     /* Awaiting its response */
+#define RPC_CALL_DONE 2u        /* Response stored for amp_rpc_call_finish() */
+#define RPC_CALL_ABANDONED 3u   /* Caller gave up; the response is dropped */
+
+/* Message header, followed by the payload */
+typedef struct {
+    uint32_t id;        /* Correlation ID */
+    int32_t code;       /* Request: method ID; response: status */
+} rpc_header_t;
+
+/* Client-side call slot */
+typedef struct {
+    uint32_t id;
+    uint32_t state;
+    amp_rpc_callback_t callback;    /* NULL for calls completed by ID */
+    void *arg;
+    int status;
+    uint32_t resp_len;
+    uint8_t *resp;                  /* max_payload bytes, calls completed by ID */
+} rpc_call_t;
+
+/* Registered method */
+typedef struct {
+    amp_rpc_handler_t handler;
+    void *ctx;
+} rpc_method_t;
+
+/* RPC structure in shared memory
+ * Client and server state are each touched by one core only
+ */
+struct amp_rpc_s {
+    AMP_LAYOUT_LINE uint64_t free;  /* Client: bitmap of free call slots */
+    uint32_t seq;                   /* Client: next call sequence number */
+    uint32_t in_flight;             /* Client: calls awaiting a response */
+    rpc_call_t *calls;
+    uint8_t *client_tx;             /* Request being sent */
+    uint8_t *client_rx;             /* Response being handled */
+    AMP_LAYOUT_LINE rpc_method_t methods[AMP_RPC_MAX_METHODS];  /* Server */
+    uint8_t *server_rx;             /* Request being handled */
+    uint8_t *server_tx;             /* Response being sent */
+    AMP_LAYOUT_LINE amp_mailbox_t requests;     /* Configuration */
+    amp_mailbox_t responses;
+    uint32_t max_payload;
+    uint32_t window;
+};
+
+/**
+ * Allocate a word-aligned block of shared memory
+ */
+static void *rpc_alloc(size_t size)
+{
+    return amp_shmem_alloc_aligned(size, sizeof(uint64_t));
+}
+
+/**
+ * Create an RPC channel
+ */
+amp_rpc_t amp_rpc_create(const amp_rpc_config_t *config)
+{
+    if (!config || config->max_payload > RPC_MAX_PAYLOAD ||
+        config->window == 0 || config->window > AMP_RPC_MAX_WINDOW) {
+        return NULL;
+    }
+
+    uint32_t window = config->window;
+    uint32_t msg_size = (uint32_t)sizeof(rpc_header_t) + config->max_payload;
+
+    /* Room for a full window of the largest messages plus the tail a
+     * record may skip, so neither side ever waits for space
+     */
+    amp_mailbox_config_t mbox_config = {
+        .msg_size = msg_size,
+        .msg_slots = window,
+        .mode = AMP_MAILBOX_MODE_VARIABLE,
+        .arena_size = (window + 1u) * (msg_size + 8u)
+    };
+
+    struct amp_rpc_s *rpc = amp_shmem_alloc_aligned(sizeof(struct amp_rpc_s),
+                                                    AMP_LAYOUT_ALIGN);
+    if (!rpc) {
+        return NULL;
+    }
+
+    rpc->requests = amp_mailbox_create(&mbox_config);
+    rpc->responses = amp_mailbox_create(&mbox_config);
+    rpc->calls = rpc_alloc(window * sizeof(rpc_call_t));
+    rpc->client_tx = rpc_alloc(msg_size);
+    rpc->client_rx = rpc_alloc(msg_size);
+    rpc->server_rx = rpc_alloc(msg_size);
+    rpc->server_tx = rpc_alloc(msg_size);
+    if (!rpc->requests || !rpc->responses || !rpc->calls || !rpc->client_tx ||
+        !rpc->client_rx || !rpc->server_rx || !rpc->server_tx) {
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < window; i++) {
+        rpc->calls[i].state = RPC_CALL_FREE;
+        rpc->calls[i].resp = NULL;
+    }
+    for (uint32_t i = 0; i < AMP_RPC_MAX_METHODS; i++) {
+        rpc->methods[i].handler = NULL;
+        rpc->methods[i].ctx = NULL;
+    }
+
+    rpc->free = (window == 64u) ? ~(uint64_t)0 : ((uint64_t)1 << window) - 1u;
+    rpc->seq = 0;
+    rpc->in_flight = 0;
+    rpc->max_payload = config->max_payload;
+    rpc->window = window;
+
+    return rpc;
+}
+
+/**
+ * Destroy an RPC channel
+ */
+void amp_rpc_destroy(amp_rpc_t rpc)
+{
+    if (!rpc) {
+        return;
+    }
+
+    amp_mailbox_destroy(rpc->requests);
+    amp_mailbox_destroy(rpc->responses);
+
+    /* Simple allocator doesn't support individual frees */
+}
+
+/**
+ * Register a method handler
+ */
+int amp_rpc_register(amp_rpc_t rpc, uint32_t method, amp_rpc_handler_t handler, void *ctx)
+{
+    if (!rpc || method >= AMP_RPC_MAX_METHODS || !handler) {
+        return -1;
+    }
+
+    rpc->methods[method].handler = handler;
+    rpc->methods[method].ctx = ctx;
+
+    return 0;
+}
+
+/**
+ * Run the handler of one request and send its response
+ */
+static void rpc_handle(amp_rpc_t rpc, uint32_t len)
+{
+    const rpc_header_t *req = (const rpc_header_t *)rpc->server_rx;
+    rpc_header_t *resp = (rpc_header_t *)rpc->server_tx;
+    uint32_t method = (uint32_t)req->code;
+    uint32_t resp_len = 0;
+    int status = AMP_RPC_NO_METHOD;
+
+    if (method < AMP_RPC_MAX_METHODS && rpc->methods[method].handler) {
+        resp_len = rpc->max_payload;
+        status = rpc->methods[method].handler(rpc->methods[method].ctx, req + 1,
+                                              len - (uint32_t)sizeof(rpc_header_t),
+                                              resp + 1, &resp_len);
+        if (resp_len > rpc->max_payload) {
+            status = AMP_RPC_ERROR;
+            resp_len = 0;
+        }
+    }
+
+    resp->id = req->id;
+    resp->code = status;
+
+    /* The response mailbox holds a full window, so this never waits */
+    (void)amp_mailbox_send_var(rpc->responses, resp,
+                               (uint32_t)sizeof(rpc_header_t) + resp_len, 0);
+}
+
+/**
+ * Handle queued requests
+ */
+uint32_t amp_rpc_serve(amp_rpc_t rpc, uint32_t timeout_ms)
+{
+    if (!rpc) {
+        return 0;
+    }
+
+    uint32_t max_len = (uint32_t)sizeof(rpc_header_t) + rpc->max_payload;
+    uint32_t len;
+
+    if (amp_mailbox_recv_var(rpc->requests, rpc->server_rx, max_len, &len,
+                             timeout_ms) != 0) {
+        return 0;
+    }
+
+    uint32_t handled = 0;
+    do {
+        if (len >= sizeof(rpc_header_t)) {
+            rpc_handle(rpc, len);
+            handled++;
+        }
+    } while (handled < rpc->window &&
+             amp_mailbox_try_recv_var(rpc->requests, rpc->server_rx, max_len, &len) == 0);
+
+    return handled;
+}
+
+/**
+ * Release a call slot
+ */
+static void rpc_release(amp_rpc_t rpc, uint32_t slot)
+{
+    rpc->calls[slot].state = RPC_CALL_FREE;
+    rpc->free |= (uint64_t)1 << slot;
+}
+
+/**
+ * Match a received response to its call and complete it
+ */
+static void rpc_complete(amp_rpc_t rpc, uint32_t len)
+{
+    const rpc_header_t *hdr = (const rpc_header_t *)rpc->client_rx;
+    uint32_t slot = hdr->id & RPC_SLOT_MASK;
+
+    if (len < sizeof(rpc_header_t) || slot >= rpc->window) {
+        return;
+    }
+
+    rpc_call_t *call = &rpc->calls[slot];
+    if (call->id != hdr->id ||
+        (call->state != RPC_CALL_PENDING && call->state != RPC_CALL_ABANDONED)) {
+        return;
+    }
+
+    uint32_t resp_len = len - (uint32_t)sizeof(rpc_header_t);
+    rpc->in_flight--;
+
+    if (call->state == RPC_CALL_ABANDONED) {
+        rpc_release(rpc, slot);
+    } else if (call->callback) {
+        /* Released first, so the callback can start another call */
+        amp_rpc_callback_t callback = call->callback;
+        void *arg = call->arg;
+        rpc_release(rpc, slot);
+        callback(arg, hdr->code, hdr + 1, resp_len);
+    } else {
+        amp_copy(call->resp, hdr + 1, resp_len);
+        call->status = hdr->code;
+        call->resp_len = resp_len;
+        call->state = RPC_CALL_DONE;
+    }
+}
+
+/**
+ * Wait for one response and complete its call
+ */
+static int rpc_recv_response(amp_rpc_t rpc, amp_time_t deadline)
+{
+    uint32_t len;
+
+    if (rpc->in_flight == 0) {
+        return -1;
+    }
+
+    if (amp_mailbox_recv_var_until(rpc->responses, rpc->client_rx,
+                                   (uint32_t)sizeof(rpc_header_t) + rpc->max_payload,
+                                   &len, deadline) != 0) {
+        return -1;
+    }
+
+    rpc_complete(rpc, len);
+
+    return 0;
+}
+
+/**
+ * Handle arrived responses
+ */
+uint32_t amp_rpc_poll(amp_rpc_t rpc)
+{
+    if (!rpc) {
+        return 0;
+    }
+
+    uint32_t max_len = (uint32_t)sizeof(rpc_header_t) + rpc->max_payload;
+    uint32_t handled = 0;
+    uint32_t len;
+
+    while (amp_mailbox_try_recv_var(rpc->responses, rpc->client_rx, max_len, &len) == 0) {
+        rpc_complete(rpc, len);
+        handled++;
+    }
+
+    return handled;
+}
+
+/**
+ * Take a call slot and send the request
+ * While the window is full, responses are handled until a slot frees up
+ */
+static int rpc_start(amp_rpc_t rpc, uint32_t method, const void *req, uint32_t req_len,
+                     amp_rpc_callback_t callback, void *arg, uint32_t *id,
+                     amp_time_t deadline)
+{
+    if (!rpc || method >= AMP_RPC_MAX_METHODS || req_len > rpc->max_payload ||
+        (!req && req_len > 0)) {
+        return -1;
+    }
+
+    while (rpc->free == 0) {
+        if (rpc_recv_response(rpc, deadline) != 0) {
+            return -1;
+        }
+    }
+
+    uint32_t slot = (uint32_t)__builtin_ctzll(rpc->free);
+    rpc_call_t *call = &rpc->calls[slot];
+
+    /* Calls completed by ID keep their own copy of the response */
+    if (!callback && !call->resp) {
+        call->resp = rpc_alloc(rpc->max_payload);
+        if (!call->resp) {
+            return -1;
+        }
+    }
+
+    rpc_header_t *hdr = (rpc_header_t *)rpc->client_tx;
+    hdr->id = (rpc->seq++ << RPC_SLOT_BITS) | slot;
+    hdr->code = (int32_t)method;
+    if (req_len > 0) {
+        amp_copy(hdr + 1, req, req_len);
+    }
+
+    /* The request mailbox holds a full window, so this never waits */
+    if (amp_mailbox_send_var_until(rpc->requests, hdr,
+                                   (uint32_t)sizeof(rpc_header_t) + req_len,
+                                   deadline) != 0) {
+        return -1;
+    }
+
+    call->id = hdr->id;
+    call->state = RPC_CALL_PENDING;
+    call->callback = callback;
+    call->arg = arg;
+    rpc->free &= ~((uint64_t)1 << slot);
+    rpc->in_flight++;
+
+    if (id) {
+        *id = hdr->id;
+    }
+
+    return 0;
+}
+
+/**
+ * Wait for the response of a call started by ID and collect it
+ */
+static int rpc_finish(amp_rpc_t rpc, uint32_t id, void *resp, uint32_t max_len,
+                      uint32_t *resp_len, amp_time_t deadline)
+{
+    uint32_t slot = id & RPC_SLOT_MASK;
+
+    if (!rpc || slot >= rpc->window) {
+        return AMP_RPC_ERROR;
+    }
+
+    rpc_call_t *call = &rpc->calls[slot];
+    if (call->id != id || call->callback ||
+        (call->state != RPC_CALL_PENDING && call->state != RPC_CALL_DONE)) {
+        return AMP_RPC_ERROR;
+    }
+
+    while (call->state == RPC_CALL_PENDING) {
+        if (rpc_recv_response(rpc, deadline) != 0) {
+            return AMP_RPC_TIMEOUT;
+        }
+    }
+
+    int status = call->status;
+    if (call->resp_len > max_len || (!resp && call->resp_len > 0)) {
+        status = AMP_RPC_ERROR;
+    } else {
+        if (call->resp_len > 0) {
+            amp_copy(resp, call->resp, call->resp_len);
+        }
+        if (resp_len) {
+            *resp_len = call->resp_len;
+        }
+    }
+
+    rpc_release(rpc, slot);
+
+    return status;
+}
+
+/**
+ * Start a call completed through a callback
+ */
+int amp_rpc_call_async(amp_rpc_t rpc, uint32_t method, const void *req, uint32_t req_len,
+                       amp_rpc_callback_t callback, void *arg, uint32_t timeout_ms)
+{
+    if (!callback) {
+        return -1;
+    }
+
+    return rpc_start(rpc, method, req, req_len, callback, arg, NULL,
+                     amp_time_deadline_ms(timeout_ms));
+}
+
+/**
+ * Start a call completed by ID
+ */
+int amp_rpc_call_start(amp_rpc_t rpc, uint32_t method, const void *req, uint32_t req_len,
+                       uint32_t *id, uint32_t timeout_ms)
+{
+    if (!id) {
+        return -1;
+    }
+
+    return rpc_start(rpc, method, req, req_len, NULL, NULL, id,
+                     amp_time_deadline_ms(timeout_ms));
+}
+
+/**
+ * Collect the response of a call started by ID
+ */
+int amp_rpc_call_finish(amp_rpc_t rpc, uint32_t id, void *resp, uint32_t max_len,
+                        uint32_t *resp_len, uint32_t timeout_ms)
+{
+    return rpc_finish(rpc, id, resp, max_len, resp_len, amp_time_deadline_ms(timeout_ms));
+}
+
+/**
+ * Call a method and wait for its response
+ */
+int amp_rpc_call(amp_rpc_t rpc, uint32_t method, const void *req, uint32_t req_len,
+                 void *resp, uint32_t max_len, uint32_t *resp_len, uint32_t timeout_ms)
+{
+    amp_time_t deadline = amp_time_deadline_ms(timeout_ms);
+    uint32_t id;
+
+    if (rpc_start(rpc, method, req, req_len, NULL, NULL, &id, deadline) != 0) {
+        return AMP_RPC_ERROR;
+    }
+
+    int status = rpc_finish(rpc, id, resp, max_len, resp_len, deadline);
+
+    /* Nobody will collect a timed-out call: drop its response on arrival */
+    if (status == AMP_RPC_TIMEOUT) {
+        rpc->calls[id & RPC_SLOT_MASK].state = RPC_CALL_ABANDONED;
+    }
+
+    return status;
+}
+
+/**
+ * Wait until every call in flight has its response
+ */
+int amp_rpc_drain(amp_rpc_t rpc, uint32_t timeout_ms)
+{
+    if (!rpc) {
+        return -1;
+    }
+
+    amp_time_t deadline = amp_time_deadline_ms(timeout_ms);
+
+    while (rpc->in_flight > 0) {
+        if (rpc_recv_response(rpc, deadline) != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Get the number of calls awaiting a response
+ */
+uint32_t amp_rpc_in_flight(amp_rpc_t rpc)
+{
+    if (!rpc) {
+        return 0;
+    }
+
+    return rpc->in_flight;
+}
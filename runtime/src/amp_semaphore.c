@@ -5,47 +5,21 @@
 
 #include "amp_semaphore.h"
 #include "amp_shmem.h"
-#include "amp_barriers.h"
+#include "amp_atomic.h"
+#include "amp_doorbell_internal.h"
+#include "amp_layout.h"
+#include "amp_poll_internal.h"
 
-/* Semaphore structure in shared memory */
+/* Semaphore structure in shared memory
+ * The count is written by every core; the limit is immutable
+ */
 struct amp_semaphore_s {
-    volatile uint32_t count;
-    uint32_t max_count;
+    AMP_LAYOUT_LINE amp_atomic_u32_t count;
+    struct amp_doorbell_s bell;     /* Rung by every post */
+    AMP_LAYOUT_LINE uint32_t max_count;
+    amp_poll_link_t poll;   /* Poll set notified by every post */
 };
 
-/**
- * Atomic compare-and-swap helper
- */
-static inline bool atomic_cas(volatile uint32_t *ptr, uint32_t old_val, uint32_t new_val)
-{
-#if defined(__ARM_ARCH) || defined(__arm__)
-    uint32_t result;
-    uint32_t tmp;
-    
-    __asm__ volatile(
-        "1: ldrex %0, [%2]\n"
-        "   cmp %0, %3\n"
-        "   bne 2f\n"
-        "   strex %1, %4, [%2]\n"
-        "   cmp %1, #0\n"
-        "   bne 1b\n"
-        "2: dmb\n"
-        : "=&r"(result), "=&r"(tmp)
-        : "r"(ptr), "r"(old_val), "r"(new_val)
-        : "cc", "memory"
-    );
-    
-    /* CAS succeeded if we read old_val
-     * (The loop retries until STREX succeeds, so if result == old_val,
-     * the store also succeeded)
-     */
-    return (result == old_val);
-#else
-    /* Use GCC built-in atomic compare-and-swap for non-ARM platforms */
-    return __sync_bool_compare_and_swap(ptr, old_val, new_val);
-#endif
-}
-
 /**
  * Create a semaphore
  */
@@ -55,13 +29,16 @@ amp_semaphore_t amp_semaphore_create(uint32_t initial_count, uint32_t max_count)
         return NULL;
     }
 
-    struct amp_semaphore_s *sem = amp_shmem_alloc(sizeof(struct amp_semaphore_s));
+    struct amp_semaphore_s *sem = amp_shmem_alloc_aligned(sizeof(struct amp_semaphore_s),
+                                                          AMP_LAYOUT_ALIGN);
     if (!sem) {
         return NULL;
     }
 
-    sem->count = initial_count;
+    amp_atomic_store_relaxed(&sem->count, initial_count);
     sem->max_count = max_count;
+    amp_doorbell_init(&sem->bell);
+    amp_poll_link_init(&sem->poll);
 
     return sem;
 }
@@ -75,6 +52,18 @@ void amp_semaphore_destroy(amp_semaphore_t sem)
     (void)sem;
 }
 
+/**
+ * Set how blocking calls on the semaphore wait
+ */
+int amp_semaphore_set_wait_policy(amp_semaphore_t sem, amp_wait_policy_t policy)
+{
+    if (!sem) {
+        return -1;
+    }
+
+    return amp_doorbell_set_policy(&sem->bell, policy);
+}
+
 /**
  * Try to wait on semaphore (non-blocking)
  */
@@ -84,16 +73,23 @@ int amp_semaphore_try_wait(amp_semaphore_t sem)
         return -1;
     }
 
-    while (1) {
-        uint32_t current = sem->count;
-        if (current == 0) {
-            return -1;
-        }
-
-        if (atomic_cas(&sem->count, current, current - 1)) {
+    /* Acquire on success: the holder's accesses stay after the take */
+    uint32_t current = amp_atomic_load_relaxed(&sem->count);
+    while (current != 0) {
+        if (amp_atomic_cas(&sem->count, &current, current - 1)) {
             return 0;
         }
     }
+
+    return -1;
+}
+
+/**
+ * Doorbell condition: the semaphore was taken
+ */
+static bool semaphore_wait_cond(void *arg)
+{
+    return amp_semaphore_try_wait((amp_semaphore_t)arg) == 0;
 }
 
 /**
@@ -101,18 +97,19 @@ int amp_semaphore_try_wait(amp_semaphore_t sem)
  */
 int amp_semaphore_wait(amp_semaphore_t sem, uint32_t timeout_ms)
 {
-    /* Simple busy-wait timeout (Phase 1 limitation)
-     * Production implementations should use hardware timers
-     */
-    uint32_t count = timeout_ms * 1000;
-    
-    while (amp_semaphore_try_wait(sem) != 0) {
-        if (timeout_ms > 0 && --count == 0) {
-            return -1;
-        }
+    return amp_semaphore_wait_until(sem, amp_time_deadline_ms(timeout_ms));
+}
+
+/**
+ * Wait on semaphore (blocking until an absolute deadline)
+ */
+int amp_semaphore_wait_until(amp_semaphore_t sem, amp_time_t deadline)
+{
+    if (!sem) {
+        return -1;
     }
-    
-    return 0;
+
+    return amp_doorbell_wait_for(&sem->bell, semaphore_wait_cond, sem, deadline);
 }
 
 /**
@@ -124,16 +121,17 @@ int amp_semaphore_post(amp_semaphore_t sem)
         return -1;
     }
 
-    while (1) {
-        uint32_t current = sem->count;
-        if (current >= sem->max_count) {
-            return -1;
-        }
-
-        if (atomic_cas(&sem->count, current, current + 1)) {
+    /* Release on success: the poster's accesses complete before the give */
+    uint32_t current = amp_atomic_load_relaxed(&sem->count);
+    while (current < sem->max_count) {
+        if (amp_atomic_cas(&sem->count, &current, current + 1)) {
+            amp_doorbell_ring(&sem->bell);
+            amp_poll_link_notify(&sem->poll);
             return 0;
         }
     }
+
+    return -1;
 }
 
 /**
@@ -145,5 +143,13 @@ uint32_t amp_semaphore_get_count(amp_semaphore_t sem)
         return 0;
     }
     
-    return sem->count;
+    return amp_atomic_load_relaxed(&sem->count);
+}
+
+/**
+ * Get the poll set link of a semaphore
+ */
+amp_poll_link_t *amp_semaphore_poll_link(amp_semaphore_t sem)
+{
+    return &sem->poll;
 }
@@ -4,33 +4,75 @@
  */
 
 #include "amp_shmem.h"
+#include "amp_shmem_internal.h"
+#include "amp_atomic.h"
+#include "amp_doorbell_internal.h"
+#include "amp_layout.h"
 #include <string.h>
 
-/* Simple memory allocator for shared memory */
+/* Marks a pool formatted by amp_shmem_init() */
+#define AMP_SHMEM_MAGIC 0x414D5053u  /* "AMPS" */
+
+/* Pool control block, kept at the start of the shared pool itself so that
+ * every core sees the same allocator and boot state, even when the cores
+ * run as separate images with no shared globals
+ */
 typedef struct {
-    void *base;
+    amp_atomic_u32_t magic;
+    amp_atomic_u32_t root;      /* Offset of the application root object, 0 = none */
     size_t size;
-    size_t allocated;
+    AMP_LAYOUT_LINE amp_atomic_u32_t allocated;     /* Offset of the first free byte */
+    AMP_LAYOUT_LINE amp_atomic_u32_t boot_flags;    /* Core ready flags, see amp_boot.c */
+    struct amp_doorbell_s boot_bell;                /* Rung when a core signals ready */
 } amp_shmem_pool_t;
 
-static amp_shmem_pool_t g_shmem_pool = {0};
+/* Pool header size, rounded to the allocation alignment */
+#define AMP_SHMEM_HEADER_SIZE ((sizeof(amp_shmem_pool_t) + 7) & ~((size_t)7))
+
+/* Per-core pointer to the pool; all state lives in the pool */
+static amp_shmem_pool_t *g_shmem_pool = NULL;
 
 /**
  * Initialize shared memory subsystem
  */
 int amp_shmem_init(void *base, size_t size)
 {
-    if (!base || size == 0) {
+    if (!base || size <= AMP_SHMEM_HEADER_SIZE || size > UINT32_MAX) {
         return -1;
     }
 
-    g_shmem_pool.base = base;
-    g_shmem_pool.size = size;
-    g_shmem_pool.allocated = 0;
-
     /* Clear the shared memory region */
     memset(base, 0, size);
 
+    amp_shmem_pool_t *pool = (amp_shmem_pool_t *)base;
+    pool->size = size;
+    amp_atomic_store_relaxed(&pool->allocated, (uint32_t)AMP_SHMEM_HEADER_SIZE);
+
+    /* Release: publish the pool only once it is fully formatted */
+    amp_atomic_store_release(&pool->magic, AMP_SHMEM_MAGIC);
+
+    g_shmem_pool = pool;
+
+    return 0;
+}
+
+/**
+ * Attach to a shared memory pool initialized by another core
+ */
+int amp_shmem_attach(void *base, size_t size)
+{
+    if (!base) {
+        return -1;
+    }
+
+    /* Acquire: the pool is not read ahead of its magic */
+    amp_shmem_pool_t *pool = (amp_shmem_pool_t *)base;
+    if (amp_atomic_load_acquire(&pool->magic) != AMP_SHMEM_MAGIC || pool->size != size) {
+        return -1;
+    }
+
+    g_shmem_pool = pool;
+
     return 0;
 }
 
@@ -40,22 +82,38 @@ int amp_shmem_init(void *base, size_t size)
  */
 void *amp_shmem_alloc(size_t size)
 {
-    if (size == 0 || !g_shmem_pool.base) {
-        return NULL;
-    }
+    return amp_shmem_alloc_aligned(size, 8);
+}
 
-    /* Align to 8-byte boundary */
-    size = (size + 7) & ~((size_t)7);
+/**
+ * Allocate an aligned shared memory region
+ */
+void *amp_shmem_alloc_aligned(size_t size, size_t align)
+{
+    amp_shmem_pool_t *pool = g_shmem_pool;
 
-    /* Check if we have enough space */
-    if (g_shmem_pool.allocated + size > g_shmem_pool.size) {
+    if (size == 0 || !pool || align < 8 || (align & (align - 1)) != 0) {
         return NULL;
     }
 
-    void *ptr = (char *)g_shmem_pool.base + g_shmem_pool.allocated;
-    g_shmem_pool.allocated += size;
+    /* Round size to the alignment */
+    size = (size + align - 1) & ~(align - 1);
+
+    /* Claim the range atomically, any core may allocate */
+    uintptr_t base = (uintptr_t)pool;
+    uint32_t offset = amp_atomic_load_relaxed(&pool->allocated);
+    size_t start;
+    do {
+        /* Align the absolute address, the pool base may be less aligned */
+        start = (size_t)(((base + offset + align - 1) & ~(uintptr_t)(align - 1)) - base);
+
+        /* Check if we have enough space */
+        if (start > pool->size || size > pool->size - start) {
+            return NULL;
+        }
+    } while (!amp_atomic_cas(&pool->allocated, &offset, (uint32_t)(start + size)));
 
-    return ptr;
+    return (char *)pool + start;
 }
 
 /**
@@ -75,21 +133,87 @@ void amp_shmem_free(void *ptr)
  */
 int amp_shmem_get_region(const void *ptr, amp_shmem_region_t *region)
 {
-    if (!ptr || !region || !g_shmem_pool.base) {
+    amp_shmem_pool_t *pool = g_shmem_pool;
+
+    if (!ptr || !region || !pool) {
         return -1;
     }
 
-    /* Check if pointer is within shared memory pool */
+    /* Check if pointer is within the allocated part of the pool */
     uintptr_t addr = (uintptr_t)ptr;
-    uintptr_t base = (uintptr_t)g_shmem_pool.base;
+    uintptr_t base = (uintptr_t)pool;
     
-    if (addr < base || addr >= base + g_shmem_pool.allocated) {
+    if (addr < base + AMP_SHMEM_HEADER_SIZE ||
+        addr >= base + amp_atomic_load_relaxed(&pool->allocated)) {
         return -1;
     }
 
-    region->base = g_shmem_pool.base;
-    region->size = g_shmem_pool.size;
+    region->base = pool;
+    region->size = pool->size;
     region->flags = 0;
 
     return 0;
 }
+
+/**
+ * Publish the application's root object
+ */
+int amp_shmem_set_root(void *root)
+{
+    amp_shmem_pool_t *pool = g_shmem_pool;
+    if (!pool) {
+        return -1;
+    }
+
+    /* Kept as an offset, the only form the pool's 32-bit words can hold */
+    uint32_t offset = 0;
+    if (root) {
+        uintptr_t addr = (uintptr_t)root;
+        uintptr_t base = (uintptr_t)pool;
+        if (addr < base + AMP_SHMEM_HEADER_SIZE || addr >= base + pool->size) {
+            return -1;
+        }
+        offset = (uint32_t)(addr - base);
+    }
+
+    /* Release: the object's contents are visible before its offset */
+    amp_atomic_store_release(&pool->root, offset);
+
+    return 0;
+}
+
+/**
+ * Get the application's root object
+ */
+void *amp_shmem_get_root(void)
+{
+    amp_shmem_pool_t *pool = g_shmem_pool;
+    if (!pool) {
+        return NULL;
+    }
+
+    /* Acquire: the object is not read ahead of its offset */
+    uint32_t offset = amp_atomic_load_acquire(&pool->root);
+
+    return offset ? (char *)pool + offset : NULL;
+}
+
+/**
+ * Get the core ready flags word kept in the shared pool
+ */
+amp_atomic_u32_t *amp_shmem_boot_flags(void)
+{
+    amp_shmem_pool_t *pool = g_shmem_pool;
+
+    return pool ? &pool->boot_flags : NULL;
+}
+
+/**
+ * Get the doorbell rung when a core signals ready
+ */
+amp_doorbell_t amp_shmem_boot_bell(void)
+{
+    amp_shmem_pool_t *pool = g_shmem_pool;
+
+    return pool ? &pool->boot_bell : NULL;
+}
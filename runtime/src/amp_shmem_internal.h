@@ -0,0 +1,38 @@
+/**
+ * @file amp_shmem_internal.h
+ * @brief Shared Memory Runtime Internals
+ * 
+ * Runtime state that must be visible to every core and therefore lives
+ * in the shared memory pool rather than in per-image globals.
+ */
+
+#ifndef AMP_SHMEM_INTERNAL_H
+#define AMP_SHMEM_INTERNAL_H
+
+#include <stdint.h>
+#include "amp_doorbell.h"
+#include "amp_atomic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Get the core ready flags word in the shared pool
+ * 
+ * @return Pointer to the flags word, or NULL if no pool is initialized
+ */
+amp_atomic_u32_t *amp_shmem_boot_flags(void);
+
+/**
+ * Get the doorbell rung when a core signals ready
+ * 
+ * @return Doorbell in the shared pool, or NULL if no pool is initialized
+ */
+amp_doorbell_t amp_shmem_boot_bell(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AMP_SHMEM_INTERNAL_H */
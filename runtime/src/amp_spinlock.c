@@ -0,0 +1,200 @@
+/**
+ * @file amp_spinlock.c
+ * @brief Fair Spinlock Implementation
+ */
+
+#include "amp_spinlock.h"
+#include "amp_config.h"
+#include "amp_shmem.h"
+#include "amp_atomic.h"
+#include "amp_layout.h"
+#include "amp_wait.h"
+
+/* MCS queue node, one per core
+ * Polled only by its own core, so each gets a line in the padded layout
+ */
+typedef struct {
+    AMP_LAYOUT_LINE amp_atomic_u32_t locked;    /* Cleared by the predecessor */
+    amp_atomic_u32_t next;                      /* Successor's core + 1, 0 = none */
+} spinlock_node_t;
+
+/* Spinlock structure in shared memory
+ * Ticket: next is taken by every acquirer, owner advanced by the holder.
+ * MCS: next is the queue tail (core + 1, 0 = free); owner is unused.
+ */
+struct amp_spinlock_s {
+    AMP_LAYOUT_LINE amp_atomic_u32_t next;
+    AMP_LAYOUT_LINE amp_atomic_u32_t owner;
+    AMP_LAYOUT_LINE uint32_t type;              /* Configuration */
+    spinlock_node_t nodes[AMP_CORE_COUNT];
+};
+
+/**
+ * Pause between checks: relax hints first, then yield the CPU
+ */
+static void spinlock_pause(uint32_t *spins)
+{
+    if (*spins < AMP_SPINLOCK_SPIN) {
+        (*spins)++;
+        amp_wait_relax();
+    } else {
+        amp_wait_yield();
+    }
+}
+
+/**
+ * Create a spinlock
+ */
+amp_spinlock_t amp_spinlock_create(amp_spinlock_type_t type)
+{
+    if (type != AMP_SPINLOCK_TICKET && type != AMP_SPINLOCK_MCS) {
+        return NULL;
+    }
+
+    struct amp_spinlock_s *lock = amp_shmem_alloc_aligned(sizeof(struct amp_spinlock_s),
+                                                          AMP_LAYOUT_ALIGN);
+    if (!lock) {
+        return NULL;
+    }
+
+    amp_atomic_store_relaxed(&lock->next, 0);
+    amp_atomic_store_relaxed(&lock->owner, 0);
+    lock->type = (uint32_t)type;
+    for (uint32_t i = 0; i < AMP_CORE_COUNT; i++) {
+        amp_atomic_store_relaxed(&lock->nodes[i].locked, 0);
+        amp_atomic_store_relaxed(&lock->nodes[i].next, 0);
+    }
+
+    /* Initialization completes before the handle reaches another core */
+    amp_atomic_fence_release();
+
+    return lock;
+}
+
+/**
+ * Destroy a spinlock
+ */
+void amp_spinlock_destroy(amp_spinlock_t lock)
+{
+    /* Simple allocator doesn't support individual frees */
+    (void)lock;
+}
+
+/**
+ * Get this core's MCS node and its queue ID (core + 1)
+ */
+static spinlock_node_t *spinlock_node(amp_spinlock_t lock, uint32_t *id)
+{
+    uint32_t core = (uint32_t)amp_get_core_id();
+
+    *id = core + 1u;
+
+    return &lock->nodes[core];
+}
+
+/**
+ * Acquire a spinlock
+ */
+void amp_spinlock_lock(amp_spinlock_t lock)
+{
+    if (!lock) {
+        return;
+    }
+
+    uint32_t spins = 0;
+
+    /* Acquire loads: the critical section stays after the handoff */
+    if (lock->type == AMP_SPINLOCK_TICKET) {
+        uint32_t ticket = amp_atomic_fetch_add(&lock->next, 1u);
+
+        while (amp_atomic_load_acquire(&lock->owner) != ticket) {
+            spinlock_pause(&spins);
+        }
+    } else {
+        uint32_t id;
+        spinlock_node_t *node = spinlock_node(lock, &id);
+
+        amp_atomic_store_relaxed(&node->next, 0);
+        amp_atomic_store_relaxed(&node->locked, 1);
+
+        /* Release: the node is ready before it is reachable */
+        uint32_t prev = amp_atomic_exchange(&lock->next, id);
+
+        if (prev != 0) {
+            amp_atomic_store_release(&lock->nodes[prev - 1u].next, id);
+            while (amp_atomic_load_acquire(&node->locked)) {
+                spinlock_pause(&spins);
+            }
+        }
+    }
+}
+
+/**
+ * Try to acquire a spinlock (non-blocking)
+ */
+int amp_spinlock_trylock(amp_spinlock_t lock)
+{
+    if (!lock) {
+        return -1;
+    }
+
+    /* Compare-and-swap acquires on success */
+    if (lock->type == AMP_SPINLOCK_TICKET) {
+        uint32_t owner = amp_atomic_load_relaxed(&lock->owner);
+
+        /* Free only while nobody holds or waits for a ticket */
+        if (amp_atomic_load_relaxed(&lock->next) != owner ||
+            !amp_atomic_cas(&lock->next, &owner, owner + 1u)) {
+            return -1;
+        }
+    } else {
+        uint32_t id;
+        spinlock_node_t *node = spinlock_node(lock, &id);
+        uint32_t tail = 0;
+
+        amp_atomic_store_relaxed(&node->next, 0);
+        amp_atomic_store_relaxed(&node->locked, 0);
+
+        if (amp_atomic_load_relaxed(&lock->next) != 0 ||
+            !amp_atomic_cas(&lock->next, &tail, id)) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Release a spinlock
+ */
+void amp_spinlock_unlock(amp_spinlock_t lock)
+{
+    if (!lock) {
+        return;
+    }
+
+    /* Release stores: the critical section completes before the handoff */
+    if (lock->type == AMP_SPINLOCK_TICKET) {
+        amp_atomic_store_release(&lock->owner, amp_atomic_load_relaxed(&lock->owner) + 1u);
+        return;
+    }
+
+    uint32_t id;
+    spinlock_node_t *node = spinlock_node(lock, &id);
+    uint32_t next = amp_atomic_load_acquire(&node->next);
+
+    if (next == 0) {
+        /* No known successor: free the lock unless one is enqueuing */
+        uint32_t tail = id;
+        if (amp_atomic_cas(&lock->next, &tail, 0u)) {
+            return;
+        }
+
+        uint32_t spins = 0;
+        while ((next = amp_atomic_load_acquire(&node->next)) == 0) {
+            spinlock_pause(&spins);
+        }
+    }
+
+    amp_atomic_store_release(&lock->nodes[next - 1u].locked, 0);
+}
@@ -0,0 +1,162 @@
+/**
+ * @file amp_time.c
+ * @brief Monotonic Time Base Implementation
+ */
+
+#if !defined(__ARM_ARCH_PROFILE) || __ARM_ARCH_PROFILE != 'M'
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "amp_time.h"
+#include "amp_config.h"
+
+/* Core clock used to scale the DWT cycle counter */
+#ifndef AMP_TIME_CPU_HZ
+#define AMP_TIME_CPU_HZ 150000000u  /* RP2350 default system clock */
+#endif
+
+#if defined(__ARM_ARCH_PROFILE) && __ARM_ARCH_PROFILE == 'M'
+
+/* DWT cycle counter (ARMv7-M / ARMv8-M) */
+#define DEMCR           (*(volatile uint32_t *)0xE000EDFCu)
+#define DEMCR_TRCENA    (1u << 24)
+#define DWT_CTRL        (*(volatile uint32_t *)0xE0001000u)
+#define DWT_CTRL_CYCENA (1u << 0)
+#define DWT_CYCCNT      (*(volatile uint32_t *)0xE0001004u)
+
+/**
+ * Get the current cycle counter
+ * Each core has its own DWT, enabled on first use
+ */
+__attribute__((weak)) uint32_t amp_time_cycles(void)
+{
+    if (!(DWT_CTRL & DWT_CTRL_CYCENA)) {
+        DEMCR |= DEMCR_TRCENA;
+        DWT_CYCCNT = 0;
+        DWT_CTRL |= DWT_CTRL_CYCENA;
+    }
+
+    return DWT_CYCCNT;
+}
+
+/**
+ * Get the cycle counter frequency
+ */
+__attribute__((weak)) uint32_t amp_time_cycle_hz(void)
+{
+    return AMP_TIME_CPU_HZ;
+}
+
+#if defined(PLATFORM_RP2350)
+
+/* RP2350 TIMER0: free-running 64-bit microsecond counter */
+#define TIMER0_BASE     0x400B0000u
+#define TIMER_TIMERAWH  (*(volatile uint32_t *)(TIMER0_BASE + 0x24u))
+#define TIMER_TIMERAWL  (*(volatile uint32_t *)(TIMER0_BASE + 0x28u))
+
+/**
+ * Get the current monotonic time from TIMER0
+ */
+__attribute__((weak)) amp_time_t amp_time_now_us(void)
+{
+    /* Raw registers are not latched: re-read until the high word is stable */
+    uint32_t high;
+    uint32_t low;
+    do {
+        high = TIMER_TIMERAWH;
+        low = TIMER_TIMERAWL;
+    } while (high != TIMER_TIMERAWH);
+
+    return ((amp_time_t)high << 32) | low;
+}
+
+#else
+
+/* Per-core extension of the 32-bit DWT counter to 64 bits */
+static uint32_t dwt_last[AMP_CORE_COUNT];
+static uint64_t dwt_high[AMP_CORE_COUNT];
+
+/**
+ * Get the current monotonic time from the DWT cycle counter
+ * Must be called at least once per counter wrap (~28s at 150MHz)
+ */
+__attribute__((weak)) amp_time_t amp_time_now_us(void)
+{
+    amp_core_t core = amp_get_core_id();
+    uint32_t now = amp_time_cycles();
+
+    if (now < dwt_last[core]) {
+        dwt_high[core] += (uint64_t)1 << 32;
+    }
+    dwt_last[core] = now;
+
+    return (dwt_high[core] | now) / (AMP_TIME_CPU_HZ / 1000000u);
+}
+
+#endif /* PLATFORM_RP2350 */
+
+#else
+
+#include <time.h>
+
+/**
+ * Read the host monotonic clock in nanoseconds
+ */
+static uint64_t host_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Get the current monotonic time from the host clock
+ */
+__attribute__((weak)) amp_time_t amp_time_now_us(void)
+{
+    return host_now_ns() / 1000u;
+}
+
+/**
+ * Get the current cycle counter
+ * Host builds count nanoseconds
+ */
+__attribute__((weak)) uint32_t amp_time_cycles(void)
+{
+    return (uint32_t)host_now_ns();
+}
+
+/**
+ * Get the cycle counter frequency
+ */
+__attribute__((weak)) uint32_t amp_time_cycle_hz(void)
+{
+    return 1000000000u;
+}
+
+#endif /* __ARM_ARCH_PROFILE == 'M' */
+
+/**
+ * Convert a relative timeout to an absolute deadline
+ */
+amp_time_t amp_time_deadline_ms(uint32_t timeout_ms)
+{
+    if (timeout_ms == 0) {
+        return AMP_TIME_FOREVER;
+    }
+
+    return amp_time_now_us() + (amp_time_t)timeout_ms * 1000u;
+}
+
+/**
+ * Check whether a deadline has passed
+ */
+bool amp_time_expired(amp_time_t deadline)
+{
+    if (deadline == AMP_TIME_FOREVER) {
+        return false;
+    }
+
+    return amp_time_now_us() >= deadline;
+}
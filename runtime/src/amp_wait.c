@@ -0,0 +1,138 @@
+/**
+ * @file amp_wait.c
+ * @brief Wait Policy Implementation
+ */
+
+#if defined(__linux__)
+#define _GNU_SOURCE
+#endif
+
+#include "amp_wait.h"
+#include "amp_doorbell_internal.h"
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+/* Global policy of this core image */
+static amp_wait_policy_t default_policy = AMP_WAIT_SLEEP;
+
+/**
+ * Set the global wait policy
+ */
+void amp_wait_set_default_policy(amp_wait_policy_t policy)
+{
+    if (policy == AMP_WAIT_DEFAULT || policy > AMP_WAIT_YIELD) {
+        policy = AMP_WAIT_SLEEP;
+    }
+
+    default_policy = policy;
+}
+
+/**
+ * Get the global wait policy
+ */
+amp_wait_policy_t amp_wait_get_default_policy(void)
+{
+    return default_policy;
+}
+
+#if defined(__linux__)
+
+/**
+ * Yield to another host thread
+ */
+__attribute__((weak)) void amp_wait_yield(void)
+{
+    (void)sched_yield();
+}
+
+#else
+
+/**
+ * No scheduler: return straight away
+ */
+__attribute__((weak)) void amp_wait_yield(void)
+{
+}
+
+#endif /* __linux__ */
+
+/* Wait on a word, see amp_wait_on_until() */
+typedef struct {
+    amp_atomic_u32_t *addr;
+    uint32_t expected;
+} wait_on_t;
+
+/**
+ * Condition: the word has changed
+ * Acquire, so data published with the word is not read ahead of it
+ */
+static bool wait_on_cond(void *arg)
+{
+    wait_on_t *wait = (wait_on_t *)arg;
+
+    return amp_atomic_load_acquire(wait->addr) != wait->expected;
+}
+
+/**
+ * Wait until a word changes, sleeping on the word itself
+ * Unlike a doorbell nobody registers, so amp_wake() always calls the hook
+ */
+static int wait_on_sleep(wait_on_t *wait, amp_time_t deadline)
+{
+    while (1) {
+        if (wait_on_cond(wait)) {
+            return 0;
+        }
+        if (amp_time_expired(deadline)) {
+            return -1;
+        }
+
+        amp_doorbell_sleep(wait->addr, wait->expected, deadline);
+    }
+}
+
+/**
+ * Wait until a word no longer holds a value (blocking)
+ */
+int amp_wait_on(amp_atomic_u32_t *addr, uint32_t expected, uint32_t timeout_ms)
+{
+    return amp_wait_on_until(addr, expected, amp_time_deadline_ms(timeout_ms));
+}
+
+/**
+ * Wait until a word no longer holds a value (blocking until an absolute deadline)
+ */
+int amp_wait_on_until(amp_atomic_u32_t *addr, uint32_t expected, amp_time_t deadline)
+{
+    if (!addr) {
+        return -1;
+    }
+
+    wait_on_t wait = { addr, expected };
+    int result = amp_doorbell_spin(wait_on_cond, &wait, deadline);
+
+    if (result > 0) {
+        amp_wait_policy_t policy = amp_wait_get_default_policy();
+        if (policy == AMP_WAIT_SLEEP) {
+            result = wait_on_sleep(&wait, deadline);
+        } else {
+            result = amp_doorbell_poll(wait_on_cond, &wait, deadline, policy);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Wake every core waiting on a word
+ */
+void amp_wake(amp_atomic_u32_t *addr)
+{
+    if (!addr) {
+        return;
+    }
+
+    amp_doorbell_wake(addr);
+}
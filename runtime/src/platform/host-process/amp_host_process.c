@@ -0,0 +1,265 @@
+/**
+ * @file amp_host_process.c
+ * @brief Host Multi-Core Simulation Platform (one process per core)
+ *
+ * Mirrors a real AMP deployment more closely than host-threads: each core
+ * runs as its own Linux process and the only memory the cores share is a
+ * named POSIX shared memory segment backing SHMEM_BASE. Secondary cores are
+ * forked from the primary, and optionally exec a separate core image.
+ *
+ * Environment:
+ * - AMP_HOST_CORE1_IMAGE: core 1 image to exec instead of calling the entry
+ *   point in the forked process. The image attaches to the segment with
+ *   amp_shmem_attach().
+ * - AMP_HOST_SHM_NAME: segment name (default "/amp-shmem-<pid of core 0>")
+ * - AMP_HOST_CORE_ID: core ID of an exec'd image (set by amp_boot_core())
+ */
+
+#define _GNU_SOURCE
+
+#include "amp_boot.h"
+#include "amp_config.h"
+#include "amp_shmem.h"
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* Size of the simulated shared SRAM segment */
+#ifndef AMP_HOST_SHMEM_SIZE
+#define AMP_HOST_SHMEM_SIZE (1024 * 1024)
+#endif
+
+/* Address the segment is mapped at in every core process, so that shared
+ * memory handles are valid in all of them (matches the RP2350 SRAM1 base)
+ */
+#ifndef AMP_HOST_SHMEM_ADDR
+#define AMP_HOST_SHMEM_ADDR 0x20040000u
+#endif
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE 0x100000
+#endif
+
+/* Core ID of this process */
+static amp_core_t host_core_id = AMP_CORE0;
+
+/* Mapped segment and its name */
+static void *host_shmem = NULL;
+static char host_shm_name[64];
+static bool host_shm_owner = false;
+
+/* Secondary core processes */
+static pid_t host_core_pids[AMP_CORE_COUNT];
+
+/**
+ * Pick up the core ID of an exec'd core image
+ */
+__attribute__((constructor)) static void host_process_init(void)
+{
+    const char *core = getenv("AMP_HOST_CORE_ID");
+    if (core) {
+        unsigned long id = strtoul(core, NULL, 10);
+        if (id < AMP_CORE_COUNT) {
+            host_core_id = (amp_core_t)id;
+        }
+
+        /* Core output behaves like a UART even when piped */
+        (void)setvbuf(stdout, NULL, _IOLBF, BUFSIZ);
+    }
+}
+
+/**
+ * Pin the calling process to the CPU simulating the given core
+ * Best effort: skipped when the host has fewer CPUs than simulated cores
+ */
+static void host_pin_to_cpu(amp_core_t core_id)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < AMP_CORE_COUNT) {
+        return;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET((size_t)core_id, &set);
+    (void)sched_setaffinity(0, sizeof(set), &set);
+}
+
+/**
+ * Stop secondary cores and remove the segment when core 0 exits
+ */
+static void host_process_cleanup(void)
+{
+    for (int core = AMP_CORE1; core < AMP_CORE_COUNT; core++) {
+        if (host_core_pids[core] > 0) {
+            (void)kill(host_core_pids[core], SIGTERM);
+            (void)waitpid(host_core_pids[core], NULL, 0);
+            host_core_pids[core] = 0;
+        }
+    }
+
+    if (host_shm_owner) {
+        (void)shm_unlink(host_shm_name);
+        host_shm_owner = false;
+    }
+}
+
+/**
+ * Map the named shared memory segment backing SHMEM_BASE
+ *
+ * Core 0 creates the segment; exec'd core images open the existing one.
+ * Returns NULL if the segment cannot be mapped at AMP_HOST_SHMEM_ADDR while
+ * an exec'd image takes part.
+ */
+void *amp_host_shmem_base(void)
+{
+    if (host_shmem) {
+        return host_shmem;
+    }
+
+    const char *name = getenv("AMP_HOST_SHM_NAME");
+    if (name) {
+        snprintf(host_shm_name, sizeof(host_shm_name), "%s", name);
+    } else {
+        snprintf(host_shm_name, sizeof(host_shm_name), "/amp-shmem-%ld", (long)getpid());
+    }
+
+    bool create = (host_core_id == AMP_CORE0);
+    int fd = shm_open(host_shm_name, create ? (O_CREAT | O_RDWR) : O_RDWR, 0600);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    if (create && ftruncate(fd, AMP_HOST_SHMEM_SIZE) != 0) {
+        (void)close(fd);
+        (void)shm_unlink(host_shm_name);
+        return NULL;
+    }
+
+    /* Kernels before 4.17 take MAP_FIXED_NOREPLACE as a hint and may map the
+     * segment elsewhere; treat that like a failed mapping
+     */
+    void *addr = (void *)(uintptr_t)AMP_HOST_SHMEM_ADDR;
+    void *base = mmap(addr, AMP_HOST_SHMEM_SIZE, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_FIXED_NOREPLACE, fd, 0);
+    if (base != MAP_FAILED && base != addr) {
+        (void)munmap(base, AMP_HOST_SHMEM_SIZE);
+        base = MAP_FAILED;
+    }
+
+    /* Any address will do only when every core is forked from this one:
+     * an exec'd image maps the segment afresh, and pointers stored in the
+     * pool must be valid in both
+     */
+    if (base == MAP_FAILED && create && !getenv("AMP_HOST_CORE1_IMAGE")) {
+        base = mmap(NULL, AMP_HOST_SHMEM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    (void)close(fd);
+
+    if (base == MAP_FAILED) {
+        if (create) {
+            (void)shm_unlink(host_shm_name);
+        }
+        return NULL;
+    }
+
+    if (create) {
+        host_shm_owner = true;
+        (void)atexit(host_process_cleanup);
+    }
+
+    host_shmem = base;
+    return host_shmem;
+}
+
+/**
+ * Get the current core ID
+ */
+amp_core_t amp_get_core_id(void)
+{
+    return host_core_id;
+}
+
+/**
+ * Boot a secondary core as a new process
+ *
+ * The forked process runs the entry point with only the shared segment in
+ * common with core 0. If AMP_HOST_CORE1_IMAGE is set, it execs that image
+ * instead. The stack pointer is ignored; the process has its own stack.
+ */
+amp_boot_status_t amp_boot_core(amp_core_t core_id, uint32_t entry_point, uint32_t stack_pointer)
+{
+    (void)stack_pointer;
+
+    if (core_id >= AMP_CORE_COUNT || core_id == AMP_CORE0) {
+        return AMP_BOOT_ERROR_INVALID_CORE;
+    }
+
+    const char *image = getenv("AMP_HOST_CORE1_IMAGE");
+    if (entry_point == 0 && !image) {
+        return AMP_BOOT_ERROR_CONFIG;
+    }
+
+    if (host_core_pids[core_id] > 0) {
+        return AMP_BOOT_ERROR_ALREADY_RUNNING;
+    }
+
+    /* The shared segment must exist before the core can attach to it */
+    if (!amp_host_shmem_base()) {
+        return AMP_BOOT_ERROR_CONFIG;
+    }
+
+    host_pin_to_cpu(AMP_CORE0);
+
+    /* Don't let the new process inherit (and repeat) buffered output */
+    (void)fflush(NULL);
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        return AMP_BOOT_ERROR_CONFIG;
+    }
+
+    if (pid == 0) {
+        /* Secondary core: never outlives core 0 */
+        (void)prctl(PR_SET_PDEATHSIG, SIGKILL);
+        (void)prctl(PR_SET_NAME, core_id == AMP_CORE1 ? "amp-core1" : "amp-core");
+
+        host_core_id = core_id;
+        host_shm_owner = false;
+
+        /* Core output behaves like a UART even when piped; glibc needs a
+         * fresh buffer to switch an already used stream to line mode
+         */
+        static char core_stdout_buf[BUFSIZ];
+        (void)setvbuf(stdout, core_stdout_buf, _IOLBF, sizeof(core_stdout_buf));
+        host_pin_to_cpu(core_id);
+
+        if (image) {
+            char core[8];
+            snprintf(core, sizeof(core), "%u", (unsigned)core_id);
+            (void)setenv("AMP_HOST_CORE_ID", core, 1);
+            (void)setenv("AMP_HOST_SHM_NAME", host_shm_name, 1);
+            execl(image, image, (char *)NULL);
+            _exit(127);
+        }
+
+        ((void (*)(void))(uintptr_t)entry_point)();
+
+        /* Skip core 0's atexit handlers */
+        (void)fflush(NULL);
+        _exit(0);
+    }
+
+    host_core_pids[core_id] = pid;
+
+    return AMP_BOOT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file amp_host_threads.c
+ * @brief Host Multi-Core Simulation Platform (POSIX threads)
+ *
+ * Overrides the weak platform symbols so that secondary cores really run:
+ * each core executes on its own OS thread pinned to a separate CPU, the
+ * core ID is kept in thread-local storage, and SHMEM_BASE is backed by a
+ * real allocation.
+ */
+
+#define _GNU_SOURCE
+
+#include "amp_boot.h"
+#include "amp_config.h"
+#include "amp_shmem.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+/* Size of the simulated shared SRAM pool */
+#ifndef AMP_HOST_SHMEM_SIZE
+#define AMP_HOST_SHMEM_SIZE (1024 * 1024)
+#endif
+
+/* Simulated shared SRAM, line aligned like the real pool */
+static char host_shmem_pool[AMP_HOST_SHMEM_SIZE] __attribute__((aligned(64)));
+
+/* Core ID of the calling thread (main thread is the primary core) */
+static _Thread_local amp_core_t tls_core_id = AMP_CORE0;
+
+/* Secondary core thread state */
+typedef struct {
+    pthread_t thread;
+    void (*entry)(void);
+    amp_core_t core_id;
+    bool running;
+} host_core_t;
+
+static host_core_t host_cores[AMP_CORE_COUNT];
+
+/**
+ * Pin the calling thread to the CPU simulating the given core
+ * Best effort: skipped when the host has fewer CPUs than simulated cores
+ */
+static void host_pin_to_cpu(amp_core_t core_id)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < AMP_CORE_COUNT) {
+        return;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET((size_t)core_id, &set);
+    (void)pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+/**
+ * Secondary core thread body
+ */
+static void *host_core_main(void *arg)
+{
+    host_core_t *core = (host_core_t *)arg;
+
+    tls_core_id = core->core_id;
+    host_pin_to_cpu(core->core_id);
+
+    core->entry();
+
+    return NULL;
+}
+
+/**
+ * Get the shared memory pool backing SHMEM_BASE
+ */
+void *amp_host_shmem_base(void)
+{
+    return host_shmem_pool;
+}
+
+/**
+ * Get the current core ID from thread-local storage
+ */
+amp_core_t amp_get_core_id(void)
+{
+    return tls_core_id;
+}
+
+/**
+ * Boot a secondary core on a new thread
+ *
+ * The stack pointer is ignored; the thread gets its own host stack.
+ */
+amp_boot_status_t amp_boot_core(amp_core_t core_id, uint32_t entry_point, uint32_t stack_pointer)
+{
+    (void)stack_pointer;
+
+    if (core_id >= AMP_CORE_COUNT || core_id == AMP_CORE0) {
+        return AMP_BOOT_ERROR_INVALID_CORE;
+    }
+
+    if (entry_point == 0) {
+        return AMP_BOOT_ERROR_CONFIG;
+    }
+
+    host_core_t *core = &host_cores[core_id];
+    if (core->running) {
+        return AMP_BOOT_ERROR_ALREADY_RUNNING;
+    }
+
+    /* The booting thread is the primary core */
+    host_pin_to_cpu(AMP_CORE0);
+
+    core->entry = (void (*)(void))(uintptr_t)entry_point;
+    core->core_id = core_id;
+
+    if (pthread_create(&core->thread, NULL, host_core_main, core) != 0) {
+        return AMP_BOOT_ERROR_CONFIG;
+    }
+
+    /* Secondary cores run forever; nothing ever joins them */
+    (void)pthread_detach(core->thread);
+    core->running = true;
+
+    return AMP_BOOT_SUCCESS;
+}
@@ -26,7 +26,7 @@ Usage: $0 [OPTIONS]
 Build the AMP MCU Reference implementation.
 
 OPTIONS:
-    -p, --platform PLATFORM    Target platform (generic, rp2350) [default: generic]
+    -p, --platform PLATFORM    Target platform (generic, rp2350, host-threads, host-process) [default: generic]
     -t, --type TYPE           Build type (Debug, Release) [default: Debug]
     -b, --build-dir DIR       Build directory [default: build]
     -c, --clean               Clean build directory before building